@@ -0,0 +1,247 @@
+#include <multi_core/multi_core.hh>
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+// state.range(0) elements, state.range(1) workers
+static void sort_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {1 << 16, 1 << 20, 1 << 24})
+	for(std::int64_t n_threads : {1, 2, 4, 8})
+	  b->Args({n_elements, n_threads});
+}
+
+static std::vector<double> random_doubles(const std::uint32_t n_elements)
+{
+  std::mt19937 mt(0);
+  std::uniform_real_distribution<double> real_dist(-1.0, 1.0);
+  std::vector<double> x(n_elements);
+  for(double & v : x)
+	v = real_dist(mt);
+  return x;
+}
+
+static void std_sort(benchmark::State & state)
+{
+  const std::vector<double> input{random_doubles(state.range(0))};
+  std::vector<double> x(input.size());
+  for(auto _ : state)
+  {
+	state.PauseTiming();
+	std::copy(input.begin(), input.end(), x.begin());
+	state.ResumeTiming();
+	std::sort(x.begin(), x.end());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(std_sort)->Apply(sort_arguments)->Unit(benchmark::kMillisecond);
+
+static void parallel_sort(benchmark::State & state)
+{
+  const std::vector<double> input{random_doubles(state.range(0))};
+  std::vector<double> x(input.size());
+  zinhart::multi_core::thread_pool::scheduler thread_pool(state.range(1));
+  for(auto _ : state)
+  {
+	state.PauseTiming();
+	std::copy(input.begin(), input.end(), x.begin());
+	state.ResumeTiming();
+	zinhart::multi_core::parallel::sort(x.begin(), x.end(), thread_pool);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_sort)->Apply(sort_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void parallel_stable_sort(benchmark::State & state)
+{
+  const std::vector<double> input{random_doubles(state.range(0))};
+  std::vector<double> x(input.size());
+  zinhart::multi_core::thread_pool::scheduler thread_pool(state.range(1));
+  for(auto _ : state)
+  {
+	state.PauseTiming();
+	std::copy(input.begin(), input.end(), x.begin());
+	state.ResumeTiming();
+	zinhart::multi_core::parallel::stable_sort(x.begin(), x.end(), thread_pool);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_stable_sort)->Apply(sort_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void parallel_radix_sort(benchmark::State & state)
+{
+  const std::vector<double> input{random_doubles(state.range(0))};
+  std::vector<double> x(input.size()), buffer(input.size());
+  zinhart::multi_core::thread_pool::scheduler thread_pool(state.range(1));
+  for(auto _ : state)
+  {
+	state.PauseTiming();
+	std::copy(input.begin(), input.end(), x.begin());
+	state.ResumeTiming();
+	zinhart::multi_core::parallel::radix_sort(x.data(), x.size(), buffer.data(), thread_pool);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_radix_sort)->Apply(sort_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// state.range(0) elements, y = a * x + y, then y = f(y), then sum(y)
+static void pipeline_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {1 << 16, 1 << 20, 1 << 24})
+	b->Arg(n_elements);
+}
+
+static void separate_passes(benchmark::State & state)
+{
+  const std::vector<double> x{random_doubles(state.range(0))};
+  std::vector<double> y{random_doubles(state.range(0))};
+  for(auto _ : state)
+  {
+	zinhart::multi_core::parallel::saxpy(0.5, x.begin(), x.end(), y.begin());
+	zinhart::multi_core::parallel::transform(y.begin(), y.end(), y.begin(), [](double v){ return v * (1.0 - v); });
+	benchmark::DoNotOptimize(zinhart::multi_core::parallel::reduce(y.begin(), y.end(), 0.0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(separate_passes)->Apply(pipeline_arguments)->UseRealTime();
+
+static void fused_pipeline(benchmark::State & state)
+{
+  using zinhart::multi_core::parallel::lazy;
+  using zinhart::multi_core::parallel::map;
+  using zinhart::multi_core::parallel::store;
+  using zinhart::multi_core::parallel::sum;
+  const std::vector<double> x{random_doubles(state.range(0))};
+  std::vector<double> y{random_doubles(state.range(0))};
+  for(auto _ : state)
+	benchmark::DoNotOptimize((0.5 * lazy(x.begin(), x.end()) + lazy(y.begin(), y.end())) | map([](double v){ return v * (1.0 - v); }) | sum());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(fused_pipeline)->Apply(pipeline_arguments)->UseRealTime();
+
+// state.range(0) elements, state.range(1) picks sequential (0) or shuffled (1) indices
+static void index_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {1 << 16, 1 << 20, 1 << 24})
+	for(std::int64_t shuffled : {0, 1})
+	  b->Args({n_elements, shuffled});
+}
+
+static std::vector<std::int32_t> benchmark_indices(const std::int64_t n_elements, const bool shuffled)
+{
+  std::vector<std::int32_t> indices(n_elements);
+  std::iota(indices.begin(), indices.end(), 0);
+  if(shuffled)
+	std::shuffle(indices.begin(), indices.end(), std::mt19937(1));
+  return indices;
+}
+
+// state.range(2) set gathers from pointers with the hardware gathers, unset gathers from iterators with the prefetching loop
+static void gather_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {1 << 16, 1 << 20, 1 << 24})
+	for(std::int64_t shuffled : {0, 1})
+	  for(std::int64_t hardware : {0, 1})
+		b->Args({n_elements, shuffled, hardware});
+}
+
+static void parallel_gather(benchmark::State & state)
+{
+  const std::vector<double> x{random_doubles(state.range(0))};
+  const std::vector<std::int32_t> indices{benchmark_indices(state.range(0), state.range(1))};
+  std::vector<double> y(x.size());
+  for(auto _ : state)
+  {
+	if(state.range(2))
+	  zinhart::multi_core::parallel::gather(indices.data(), indices.data() + indices.size(), x.data(), y.data());
+	else
+	  zinhart::multi_core::parallel::gather(indices.begin(), indices.end(), x.begin(), y.begin());
+	benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_gather)->Apply(gather_arguments)->UseRealTime();
+
+static void parallel_scatter(benchmark::State & state)
+{
+  const std::vector<double> x{random_doubles(state.range(0))};
+  const std::vector<std::int32_t> indices{benchmark_indices(state.range(0), state.range(1))};
+  std::vector<double> y(x.size());
+  for(auto _ : state)
+  {
+	zinhart::multi_core::parallel::scatter(x.data(), x.data() + x.size(), indices.data(), y.data());
+	benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_scatter)->Apply(index_arguments)->UseRealTime();
+
+static void parallel_permute(benchmark::State & state)
+{
+  std::vector<double> x{random_doubles(state.range(0))};
+  const std::vector<std::int32_t> indices{benchmark_indices(state.range(0), state.range(1))};
+  for(auto _ : state)
+  {
+	zinhart::multi_core::parallel::permute(x.data(), x.data() + x.size(), indices.data());
+	benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_permute)->Apply(index_arguments)->UseRealTime();
+
+// the state.range(1) largest of state.range(0) doubles
+static void selection_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {1 << 20, 1 << 24})
+	for(std::int64_t k : {10, 1000, 100000})
+	  b->Args({n_elements, k});
+}
+
+static void std_partial_sort(benchmark::State & state)
+{
+  const std::vector<double> x{random_doubles(state.range(0))};
+  std::vector<double> y(x.size());
+  for(auto _ : state)
+  {
+	state.PauseTiming();
+	std::copy(x.begin(), x.end(), y.begin());
+	state.ResumeTiming();
+	std::partial_sort(y.begin(), y.begin() + state.range(1), y.end(), std::greater<double>());
+	benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(std_partial_sort)->Apply(selection_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void parallel_partial_sort(benchmark::State & state)
+{
+  const std::vector<double> x{random_doubles(state.range(0))};
+  std::vector<double> y(x.size());
+  for(auto _ : state)
+  {
+	state.PauseTiming();
+	std::copy(x.begin(), x.end(), y.begin());
+	state.ResumeTiming();
+	zinhart::multi_core::parallel::partial_sort(y.begin(), y.begin() + state.range(1), y.end(), std::greater<double>());
+	benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_partial_sort)->Apply(selection_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// reads the input in place and writes only the k values and positions
+static void parallel_top_k(benchmark::State & state)
+{
+  const std::vector<double> x{random_doubles(state.range(0))};
+  std::vector<double> values(state.range(1));
+  std::vector<std::size_t> indices(state.range(1));
+  for(auto _ : state)
+  {
+	zinhart::multi_core::parallel::top_k(x.begin(), x.end(), values.size(), values.begin(), indices.begin());
+	benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parallel_top_k)->Apply(selection_arguments)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -1,2 +1,138 @@
+#include <multi_core/multi_core.hh>
 #include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+// state.range(0) elements, small enough to stay in cache so the sums are compute bound
+static void sum_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {1 << 10, 1 << 14, 1 << 18})
+	b->Arg(n_elements);
+}
+
+template <class precision_type>
+  static std::vector<precision_type> random_reals(const std::size_t n_elements)
+  {
+	std::mt19937 mt(0);
+	std::uniform_real_distribution<precision_type> real_dist(-1.0, 1.0);
+	std::vector<precision_type> x(n_elements);
+	for(precision_type & v : x)
+	  v = real_dist(mt);
+	return x;
+  }
+
+template <class precision_type>
+  static void std_accumulate(benchmark::State & state)
+  {
+	const std::vector<precision_type> x{random_reals<precision_type>(state.range(0))};
+	for(auto _ : state)
+	  benchmark::DoNotOptimize(std::accumulate(x.begin(), x.end(), precision_type{0}));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+BENCHMARK_TEMPLATE(std_accumulate, float)->Apply(sum_arguments);
+BENCHMARK_TEMPLATE(std_accumulate, double)->Apply(sum_arguments);
+
+template <class precision_type>
+  static void simd_accumulate(benchmark::State & state)
+  {
+	const std::vector<precision_type> x{random_reals<precision_type>(state.range(0))};
+	for(auto _ : state)
+	  benchmark::DoNotOptimize(zinhart::multi_core::simd::accumulate(x.data(), x.size()));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+BENCHMARK_TEMPLATE(simd_accumulate, float)->Apply(sum_arguments);
+BENCHMARK_TEMPLATE(simd_accumulate, double)->Apply(sum_arguments);
+
+template <class precision_type>
+  static void simd_kahan_sum(benchmark::State & state)
+  {
+	const std::vector<precision_type> x{random_reals<precision_type>(state.range(0))};
+	for(auto _ : state)
+	  benchmark::DoNotOptimize(zinhart::multi_core::simd::kahan_sum(x.data(), x.size()));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+BENCHMARK_TEMPLATE(simd_kahan_sum, float)->Apply(sum_arguments);
+BENCHMARK_TEMPLATE(simd_kahan_sum, double)->Apply(sum_arguments);
+
+template <class precision_type>
+  static void simd_neumaier_sum(benchmark::State & state)
+  {
+	const std::vector<precision_type> x{random_reals<precision_type>(state.range(0))};
+	for(auto _ : state)
+	  benchmark::DoNotOptimize(zinhart::multi_core::simd::neumaier_sum(x.data(), x.size()));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+BENCHMARK_TEMPLATE(simd_neumaier_sum, float)->Apply(sum_arguments);
+BENCHMARK_TEMPLATE(simd_neumaier_sum, double)->Apply(sum_arguments);
+
+// the portable lanes behind the binary predicate versions
+template <class precision_type>
+  static void kahan_lanes(benchmark::State & state)
+  {
+	const std::vector<precision_type> x{random_reals<precision_type>(state.range(0))};
+	for(auto _ : state)
+	  benchmark::DoNotOptimize(zinhart::multi_core::simd::kahan_lanes<precision_type>([&x](std::size_t i){ return x[i]; }, x.size()));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+BENCHMARK_TEMPLATE(kahan_lanes, double)->Apply(sum_arguments);
+
+// outputs from a few times smaller to many times larger than the last level cache
+static void stream_arguments(benchmark::internal::Benchmark * b)
+{
+  for(std::int64_t n_elements : {std::int64_t{1} << 20, std::int64_t{1} << 24, std::int64_t{1} << 26})
+	b->Arg(n_elements);
+}
+
+static void cached_copy(benchmark::State & state)
+{
+  const std::vector<double> x(state.range(0), 1.0);
+  std::vector<double> y(state.range(0));
+  for(auto _ : state)
+  {
+	zinhart::multi_core::simd::copy(x.data(), y.data(), y.size());
+	benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double) * 2);
+}
+BENCHMARK(cached_copy)->Apply(stream_arguments);
+
+static void stream_copy(benchmark::State & state)
+{
+  const std::vector<double> x(state.range(0), 1.0);
+  std::vector<double> y(state.range(0));
+  for(auto _ : state)
+  {
+	zinhart::multi_core::simd::stream_copy(x.data(), y.data(), y.size());
+	benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double) * 2);
+}
+BENCHMARK(stream_copy)->Apply(stream_arguments);
+
+static void cached_fill(benchmark::State & state)
+{
+  std::vector<double> y(state.range(0));
+  for(auto _ : state)
+  {
+	std::fill(y.begin(), y.end(), 2.0);
+	benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+}
+BENCHMARK(cached_fill)->Apply(stream_arguments);
+
+static void stream_fill(benchmark::State & state)
+{
+  std::vector<double> y(state.range(0));
+  for(auto _ : state)
+  {
+	zinhart::multi_core::simd::stream_fill(y.data(), y.size(), 2.0);
+	benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+}
+BENCHMARK(stream_fill)->Apply(stream_arguments);
+
 BENCHMARK_MAIN();
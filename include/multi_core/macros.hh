@@ -20,4 +20,6 @@
 #include <thread>
 #include <cstdint>
 #define MAX_CPU_THREADS std::thread::hardware_concurrency()
+// used to pad shared counters so that they do not share a cache line with anything else
+#define CACHE_LINE_SIZE 64
 #endif
@@ -1,9 +1,23 @@
 #ifndef MULTI_CORE_HH
 #define MULTI_CORE_HH
 #include <multi_core/macros.hh>
+#include <multi_core/parallel/slot_map.hh>
 #include <multi_core/parallel/task_manager.hh>
 #include <multi_core/parallel/thread_pool.hh>
 #include <multi_core/parallel/parallel.hh>
+#include <multi_core/parallel/simd.hh>
+#include <multi_core/parallel/random.hh>
+#include <multi_core/parallel/fork_join.hh>
+#include <multi_core/parallel/algorithms.hh>
+#include <multi_core/parallel/reduce.hh>
+#include <multi_core/parallel/expression.hh>
+#include <multi_core/parallel/histogram.hh>
+#include <multi_core/parallel/search.hh>
+#include <multi_core/parallel/segmented.hh>
+#include <multi_core/parallel/scan.hh>
+#include <multi_core/parallel/sort.hh>
+#include <multi_core/parallel/select.hh>
+#include <multi_core/parallel/radix_sort.hh>
 #include <multi_core/serial/serial.hh>
 #include "timer.hh"
 namespace zinhart
@@ -0,0 +1,111 @@
+#ifndef ZINHART_ALGORITHMS_HH
+#define ZINHART_ALGORITHMS_HH
+#include <multi_core/parallel/reduce.hh>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Synchronous front-ends over the scheduler. Each call partitions [first, last), runs the chunks on the scheduler's workers and the calling thread
+	 * and returns once every chunk is done, so unlike async:: there are no futures for the caller to manage. Iterators must be random access.
+	 * Every algorithm defaults to auto_schedule, static chunks of at least min_bytes_per_task so short ranges run on fewer threads or inline,
+	 * the overloads taking a schedule use its chunks instead, prefer dynamic or guided chunks when the cost per element varies.
+	 * */
+	namespace parallel
+	{
+	  template <class InputIt, class UnaryFunction>
+		HOST void for_each(InputIt first, InputIt last, UnaryFunction f, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class UnaryFunction>
+		HOST void for_each(InputIt first, InputIt last, UnaryFunction f, const schedule & policy, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class UnaryOperation>
+		HOST OutputIt transform(InputIt first, InputIt last, OutputIt output_first, UnaryOperation unary_op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class UnaryOperation>
+		HOST OutputIt transform(InputIt first, InputIt last, OutputIt output_first, UnaryOperation unary_op, const schedule & policy,
+		                        thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class OutputIt, class BinaryOperation>
+		HOST OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt output_first, BinaryOperation binary_op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class OutputIt, class BinaryOperation>
+		HOST OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt output_first, BinaryOperation binary_op, const schedule & policy,
+		                        thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt>
+		HOST OutputIt copy(InputIt first, InputIt last, OutputIt output_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // copy and fill write outputs at least simd::get_streaming_threshold() bytes long with non-temporal stores
+	  template <class ForwardIt, class T>
+		HOST void fill(ForwardIt first, ForwardIt last, const T & value, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // y = a * x + y
+	  template <class precision_type, class InputIt, class OutputIt>
+		HOST void saxpy(const precision_type a, InputIt x_first, InputIt x_last, OutputIt y_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  /*
+	   * Indexed moves, the reordering step after sorting indices. gather reads through the indices and writes in order, scatter reads in order and writes
+	   * through the indices, both prefetch ahead of their indirect accesses and pointers to float or double with 32 bit or 64 bit indices gather
+	   * with the hardware gathers. Indices must be in range.
+	   * */
+	  // *(output_first + i) = *(input_first + *(index_first + i))
+	  template <class IndexIt, class InputIt, class OutputIt>
+		HOST OutputIt gather(IndexIt index_first, IndexIt index_last, InputIt input_first, OutputIt output_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // *(output_first + *(index_first + i)) = *(first + i), the indices must be distinct as chunks race on a repeated index
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void scatter(InputIt first, InputIt last, IndexIt index_first, OutputIt output_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // scatter into [output_first, output_last) where a repeated index keeps the element at the highest position, as a serial loop would.
+	  // A first pass raises an atomic owner per output to the highest position writing it and a second pass writes only the owners
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void scatter_last(InputIt first, InputIt last, IndexIt index_first, OutputIt output_first, OutputIt output_last,
+		                       thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // reorders [first, last) in place so that *(first + i) holds the old *(first + *(index_first + i)), gathers into a buffer and copies it back
+	  template <class RandomIt, class IndexIt>
+		HOST void permute(RandomIt first, RandomIt last, IndexIt index_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  /*
+	   * Stream compaction. pred is called once per element, the first pass stores the result in a byte per element and counts matches per chunk,
+	   * the chunk counts are scanned into output offsets and the second pass writes each chunk's matches densely starting at its offset.
+	   * The relative order of the elements is preserved and the end of the written output is returned.
+	   * */
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, const schedule & policy,
+		                      thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt remove_copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt remove_copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, const schedule & policy,
+		                             thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt1, class OutputIt2, class UnaryPredicate>
+		HOST std::pair<OutputIt1, OutputIt2> partition_copy(InputIt first, InputIt last, OutputIt1 output_true, OutputIt2 output_false, UnaryPredicate pred,
+		                                                     thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt1, class OutputIt2, class UnaryPredicate>
+		HOST std::pair<OutputIt1, OutputIt2> partition_copy(InputIt first, InputIt last, OutputIt1 output_true, OutputIt2 output_false, UnaryPredicate pred,
+		                                                     const schedule & policy, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the engine behind the three above, writes the elements where pred == keep to output_true and, when write_false is set, the rest to output_false.
+	  // returns the number of elements written to output_true
+	  template <class InputIt, class OutputIt1, class OutputIt2, class UnaryPredicate>
+		HOST std::size_t compact_chunks(InputIt first, const std::size_t n_elements, OutputIt1 output_true, OutputIt2 output_false, UnaryPredicate pred,
+		                                  const bool keep, const bool write_false, const schedule & policy, thread_pool::scheduler & scheduler);
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/algorithms.tcc>
+#endif
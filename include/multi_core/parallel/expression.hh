@@ -0,0 +1,261 @@
+#ifndef ZINHART_EXPRESSION_HH
+#define ZINHART_EXPRESSION_HH
+#include <multi_core/parallel/reduce.hh>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Lazy elementwise expressions. Arithmetic on lazy(first, last) ranges and scalars builds a tree of nodes instead of running a pass,
+	 * | map(f) adds a node that applies f to each element, and nothing runs until the tree is piped into store, fold or sum.
+	 * Those run one fork_join over auto_schedule chunks, as the other algorithms do, and each chunk evaluates the whole tree
+	 * element by element, so a chain like
+	 *   (a * lazy(x.begin(), x.end()) + lazy(y.begin(), y.end())) | map(f) | sum()
+	 * reads x and y once instead of once per step. Leaves hold iterators, the ranges must outlive the expression.
+	 * */
+	namespace parallel
+	{
+	  // a random access range
+	  template <class RandomIt>
+		class terminal_expression
+		{
+		  public:
+			using value_type = typename std::iterator_traits<RandomIt>::value_type;
+			HOST terminal_expression(RandomIt first, const std::size_t n_elements);
+			HOST auto operator[](const std::size_t i)const -> decltype(*std::declval<RandomIt>());
+			HOST std::size_t size()const;
+			// bytes each element reads, sets how many chunks are worth it
+			HOST std::size_t bytes_per_element()const;
+		  private:
+			RandomIt first;
+			std::size_t n_elements;
+		};
+
+	  // the same value at every index, fits any size
+	  template <class T>
+		class scalar_expression
+		{
+		  public:
+			using value_type = T;
+			HOST scalar_expression(const T & value);
+			HOST const T & operator[](const std::size_t i)const;
+			HOST std::size_t size()const;
+			HOST std::size_t bytes_per_element()const;
+		  private:
+			T value;
+		};
+
+	  template <class UnaryOperation, class Expression>
+		class unary_expression
+		{
+		  public:
+			using value_type = typename std::decay<decltype(std::declval<UnaryOperation>()(std::declval<Expression>()[0]))>::type;
+			HOST unary_expression(const Expression & operand, UnaryOperation op);
+			HOST value_type operator[](const std::size_t i)const;
+			HOST std::size_t size()const;
+			HOST std::size_t bytes_per_element()const;
+		  private:
+			Expression operand;
+			UnaryOperation op;
+		};
+
+	  // sized by the shorter operand
+	  template <class BinaryOperation, class Left, class Right>
+		class binary_expression
+		{
+		  public:
+			using value_type = typename std::decay<decltype(std::declval<BinaryOperation>()(std::declval<Left>()[0], std::declval<Right>()[0]))>::type;
+			HOST binary_expression(const Left & left, const Right & right, BinaryOperation op);
+			HOST value_type operator[](const std::size_t i)const;
+			HOST std::size_t size()const;
+			HOST std::size_t bytes_per_element()const;
+		  private:
+			Left left;
+			Right right;
+			BinaryOperation op;
+		};
+
+	  template <class T>
+		struct is_expression : std::false_type {};
+	  template <class RandomIt>
+		struct is_expression<terminal_expression<RandomIt>> : std::true_type {};
+	  template <class T>
+		struct is_expression<scalar_expression<T>> : std::true_type {};
+	  template <class UnaryOperation, class Expression>
+		struct is_expression<unary_expression<UnaryOperation, Expression>> : std::true_type {};
+	  template <class BinaryOperation, class Left, class Right>
+		struct is_expression<binary_expression<BinaryOperation, Left, Right>> : std::true_type {};
+
+	  // the operators of the nodes built by + - * / and unary -
+	  class add_op
+	  {
+		public:
+		  template <class A, class B>
+			HOST auto operator()(const A & a, const B & b)const -> decltype(a + b)
+			{ return a + b; }
+	  };
+	  class subtract_op
+	  {
+		public:
+		  template <class A, class B>
+			HOST auto operator()(const A & a, const B & b)const -> decltype(a - b)
+			{ return a - b; }
+	  };
+	  class multiply_op
+	  {
+		public:
+		  template <class A, class B>
+			HOST auto operator()(const A & a, const B & b)const -> decltype(a * b)
+			{ return a * b; }
+	  };
+	  class divide_op
+	  {
+		public:
+		  template <class A, class B>
+			HOST auto operator()(const A & a, const B & b)const -> decltype(a / b)
+			{ return a / b; }
+	  };
+	  class negate_op
+	  {
+		public:
+		  template <class A>
+			HOST auto operator()(const A & a)const -> decltype(-a)
+			{ return -a; }
+	  };
+
+	  // a leaf over [first, last)
+	  template <class RandomIt>
+		HOST terminal_expression<RandomIt> lazy(RandomIt first, RandomIt last);
+
+	  // an expression operand as a node, expressions pass through and arithmetic values become scalar_expressions
+	  template <class T, bool = is_expression<T>::value>
+		struct as_expression
+		{
+		  using type = T;
+		  HOST static const T & wrap(const T & value)
+		  { return value; }
+		};
+	  template <class T>
+		struct as_expression<T, false>
+		{
+		  using type = scalar_expression<T>;
+		  HOST static scalar_expression<T> wrap(const T & value)
+		  { return scalar_expression<T>(value); }
+		};
+
+	  // enabled when at least one operand is an expression and the other is an expression or an arithmetic value
+	  template <class Left, class Right>
+		struct enable_binary_expression : std::enable_if<(is_expression<Left>::value && (is_expression<Right>::value || std::is_arithmetic<Right>::value)) ||
+		                                                 (std::is_arithmetic<Left>::value && is_expression<Right>::value)>
+		{};
+
+	  template <class Left, class Right, class = typename enable_binary_expression<Left, Right>::type>
+		HOST binary_expression<add_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator + (const Left & left, const Right & right);
+	  template <class Left, class Right, class = typename enable_binary_expression<Left, Right>::type>
+		HOST binary_expression<subtract_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator - (const Left & left, const Right & right);
+	  template <class Left, class Right, class = typename enable_binary_expression<Left, Right>::type>
+		HOST binary_expression<multiply_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator * (const Left & left, const Right & right);
+	  template <class Left, class Right, class = typename enable_binary_expression<Left, Right>::type>
+		HOST binary_expression<divide_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator / (const Left & left, const Right & right);
+	  template <class Expression, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST unary_expression<negate_op, Expression> operator - (const Expression & operand);
+
+	  // | map(f) applies f to each element, lazily
+	  template <class UnaryOperation>
+		class map_adaptor
+		{
+		  public:
+			HOST map_adaptor(UnaryOperation op);
+			HOST const UnaryOperation & get_op()const;
+		  private:
+			UnaryOperation op;
+		};
+	  template <class UnaryOperation>
+		HOST map_adaptor<UnaryOperation> map(UnaryOperation op);
+	  template <class Expression, class UnaryOperation, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST unary_expression<UnaryOperation, Expression> operator | (const Expression & expression, const map_adaptor<UnaryOperation> & adaptor);
+
+	  // the passes, each is one fork_join over the expression's size
+
+	  // *(output_first + i) = expression[i], output_first may be one of the expression's ranges
+	  template <class Expression, class OutputIt, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST OutputIt store(const Expression & expression, OutputIt output_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	  // init op expression[0] op expression[1] ..., op must be associative, the elements are combined in order
+	  template <class Expression, class T, class BinaryOperation, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST T fold(const Expression & expression, T init, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	  // init + the sum of the elements, each chunk keeps several partial sums so the adds overlap, the order of the additions differs from fold
+	  template <class Expression, class T, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST T sum(const Expression & expression, T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the same passes as the end of a pipe, expression | store(y.begin()) or expression | sum()
+	  template <class OutputIt>
+		class store_adaptor
+		{
+		  public:
+			HOST store_adaptor(OutputIt output_first, thread_pool::scheduler & scheduler);
+			template <class Expression>
+			  HOST OutputIt operator()(const Expression & expression)const;
+		  private:
+			OutputIt output_first;
+			thread_pool::scheduler * scheduler;
+		};
+	  template <class T, class BinaryOperation>
+		class fold_adaptor
+		{
+		  public:
+			HOST fold_adaptor(const T & init, BinaryOperation op, thread_pool::scheduler & scheduler);
+			template <class Expression>
+			  HOST T operator()(const Expression & expression)const;
+		  private:
+			T init;
+			BinaryOperation op;
+			thread_pool::scheduler * scheduler;
+		};
+	  template <class T>
+		class sum_adaptor
+		{
+		  public:
+			HOST sum_adaptor(const T & init, thread_pool::scheduler & scheduler);
+			template <class Expression>
+			  HOST T operator()(const Expression & expression)const;
+		  private:
+			T init;
+			thread_pool::scheduler * scheduler;
+		};
+	  // without an init the sum starts from a value initialized element of the expression
+	  template <>
+		class sum_adaptor<void>
+		{
+		  public:
+			HOST sum_adaptor(thread_pool::scheduler & scheduler)
+			  : scheduler(&scheduler)
+			{}
+			template <class Expression>
+			  HOST typename Expression::value_type operator()(const Expression & expression)const;
+		  private:
+			thread_pool::scheduler * scheduler;
+		};
+	  template <class OutputIt>
+		HOST store_adaptor<OutputIt> store(OutputIt output_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	  template <class T, class BinaryOperation>
+		HOST fold_adaptor<T, BinaryOperation> fold(T init, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	  template <class T = void>
+		HOST sum_adaptor<T> sum(thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	  template <class T>
+		HOST sum_adaptor<T> sum(T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class Expression, class OutputIt, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST OutputIt operator | (const Expression & expression, const store_adaptor<OutputIt> & adaptor);
+	  template <class Expression, class T, class BinaryOperation, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST T operator | (const Expression & expression, const fold_adaptor<T, BinaryOperation> & adaptor);
+	  template <class Expression, class T, class = typename std::enable_if<is_expression<Expression>::value>::type>
+		HOST auto operator | (const Expression & expression, const sum_adaptor<T> & adaptor) -> decltype(adaptor(expression));
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/expression.tcc>
+#endif
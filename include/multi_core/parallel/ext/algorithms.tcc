@@ -0,0 +1,242 @@
+#ifndef ZINHART_ALGORITHMS_TCC
+#define ZINHART_ALGORITHMS_TCC
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class InputIt, class UnaryFunction>
+		HOST void for_each(InputIt first, InputIt last, UnaryFunction f, thread_pool::scheduler & scheduler)
+		{ for_each(first, last, f, auto_schedule(sizeof(typename std::iterator_traits<InputIt>::value_type)), scheduler); }
+
+	  template <class InputIt, class UnaryFunction>
+		HOST void for_each(InputIt first, InputIt last, UnaryFunction f, const schedule & policy, thread_pool::scheduler & scheduler)
+		{
+		  fork_join(std::distance(first, last), policy, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+				f( *(first + op) );
+			}, scheduler
+		  );
+		}
+
+	  template <class InputIt, class OutputIt, class UnaryOperation>
+		HOST OutputIt transform(InputIt first, InputIt last, OutputIt output_first, UnaryOperation unary_op, thread_pool::scheduler & scheduler)
+		{ return transform(first, last, output_first, unary_op, auto_schedule(sizeof(typename std::iterator_traits<InputIt>::value_type)), scheduler); }
+
+	  template <class InputIt, class OutputIt, class UnaryOperation>
+		HOST OutputIt transform(InputIt first, InputIt last, OutputIt output_first, UnaryOperation unary_op, const schedule & policy, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  fork_join(n_elements, policy, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+				*(output_first + op) = unary_op( *(first + op) );
+			}, scheduler
+		  );
+		  return output_first + n_elements;
+		}
+
+	  template <class InputIt1, class InputIt2, class OutputIt, class BinaryOperation>
+		HOST OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt output_first, BinaryOperation binary_op, thread_pool::scheduler & scheduler)
+		{ return transform(first1, last1, first2, output_first, binary_op, auto_schedule(sizeof(typename std::iterator_traits<InputIt1>::value_type)), scheduler); }
+
+	  template <class InputIt1, class InputIt2, class OutputIt, class BinaryOperation>
+		HOST OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt output_first, BinaryOperation binary_op, const schedule & policy,
+		                        thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first1, last1);
+		  fork_join(n_elements, policy, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+				*(output_first + op) = binary_op( *(first1 + op), *(first2 + op) );
+			}, scheduler
+		  );
+		  return output_first + n_elements;
+		}
+
+	  template <class InputIt, class OutputIt>
+		HOST OutputIt copy(InputIt first, InputIt last, OutputIt output_first, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t value_bytes{sizeof(typename std::iterator_traits<InputIt>::value_type)};
+		  // decided once for the whole output, every chunk fences its own streaming stores before the join
+		  const bool streaming{simd::use_streaming_stores(n_elements * value_bytes)};
+		  fork_join(n_elements, auto_schedule(value_bytes), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  if(streaming)
+				simd::stream_copy(first + start, output_first + start, stop - start);
+			  else
+				simd::copy(first + start, output_first + start, stop - start);
+			}, scheduler
+		  );
+		  return output_first + n_elements;
+		}
+
+	  template <class ForwardIt, class T>
+		HOST void fill(ForwardIt first, ForwardIt last, const T & value, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+		  const std::size_t n_elements = std::distance(first, last);
+		  const value_type converted(value);
+		  const bool streaming{simd::use_streaming_stores(n_elements * sizeof(value_type))};
+		  fork_join(n_elements, auto_schedule(sizeof(value_type)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  if(streaming)
+				simd::stream_fill(first + start, stop - start, converted);
+			  else
+				std::fill(first + start, first + stop, converted);
+			}, scheduler
+		  );
+		}
+
+	  template <class precision_type, class InputIt, class OutputIt>
+		HOST void saxpy(const precision_type a, InputIt x_first, InputIt x_last, OutputIt y_first, thread_pool::scheduler & scheduler)
+		{
+		  fork_join(std::distance(x_first, x_last), auto_schedule(sizeof(typename std::iterator_traits<InputIt>::value_type)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{ simd::saxpy(a, x_first + start, y_first + start, stop - start); }, scheduler
+		  );
+		}
+
+	  template <class IndexIt, class InputIt, class OutputIt>
+		HOST OutputIt gather(IndexIt index_first, IndexIt index_last, InputIt input_first, OutputIt output_first, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(index_first, index_last);
+		  const std::size_t bytes_per_element{sizeof(typename std::iterator_traits<IndexIt>::value_type) + 2 * sizeof(typename std::iterator_traits<InputIt>::value_type)};
+		  fork_join(n_elements, auto_schedule(bytes_per_element), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{ simd::gather(input_first, index_first + start, output_first + start, stop - start); }, scheduler
+		  );
+		  return output_first + n_elements;
+		}
+
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void scatter(InputIt first, InputIt last, IndexIt index_first, OutputIt output_first, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t bytes_per_element{sizeof(typename std::iterator_traits<IndexIt>::value_type) + 2 * sizeof(typename std::iterator_traits<InputIt>::value_type)};
+		  fork_join(std::distance(first, last), auto_schedule(bytes_per_element), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{ simd::scatter(first + start, index_first + start, output_first, stop - start); }, scheduler
+		  );
+		}
+
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void scatter_last(InputIt first, InputIt last, IndexIt index_first, OutputIt output_first, OutputIt output_last, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t index_bytes{sizeof(typename std::iterator_traits<IndexIt>::value_type)};
+		  // position + 1 of the element that writes each output, 0 while none does
+		  std::vector<std::atomic<std::size_t>> owners(std::distance(output_first, output_last));
+		  fork_join(n_elements, auto_schedule(index_bytes + sizeof(std::size_t)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+			  {
+				std::atomic<std::size_t> & owner = owners[*(index_first + op)];
+				std::size_t current{owner.load(std::memory_order_relaxed)};
+				while(current < op + 1 && !owner.compare_exchange_weak(current, op + 1, std::memory_order_relaxed))
+				  ;
+			  }
+			}, scheduler
+		  );
+		  // the join orders every owner before these loads
+		  fork_join(n_elements, auto_schedule(index_bytes + sizeof(std::size_t) + 2 * sizeof(typename std::iterator_traits<InputIt>::value_type)),
+			[&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+			  {
+				const auto index = *(index_first + op);
+				if(owners[index].load(std::memory_order_relaxed) == op + 1)
+				  *(output_first + index) = *(first + op);
+			  }
+			}, scheduler
+		  );
+		}
+
+	  template <class RandomIt, class IndexIt>
+		HOST void permute(RandomIt first, RandomIt last, IndexIt index_first, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  // default initialized so trivial elements are first touched by the gather's chunks rather than zeroed serially
+		  std::unique_ptr<typename std::iterator_traits<RandomIt>::value_type[]> gathered(new typename std::iterator_traits<RandomIt>::value_type[n_elements]);
+		  gather(index_first, index_first + n_elements, first, gathered.get(), scheduler);
+		  parallel::copy(gathered.get(), gathered.get() + n_elements, first, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt1, class OutputIt2, class UnaryPredicate>
+		HOST std::size_t compact_chunks(InputIt first, const std::size_t n_elements, OutputIt1 output_true, OutputIt2 output_false, UnaryPredicate pred,
+		                                  const bool keep, const bool write_false, const schedule & policy, thread_pool::scheduler & scheduler)
+		{
+		  if(n_elements == 0)
+			return 0;
+		  // both passes must see the same chunks
+		  const chunk_plan plan(policy, n_elements, scheduler.size() + 1);
+		  const std::size_t n_chunks{plan.size()};
+		  std::vector<std::uint8_t> flags(n_elements);
+		  std::vector<padded_partial<std::size_t>> offsets(n_chunks);
+		  fork_join(plan, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  std::size_t count{0};
+			  for(std::size_t op = start; op < stop; ++op)
+			  {
+				const bool match{bool(pred( *(first + op) )) == keep};
+				flags[op] = match;
+				count += match;
+			  }
+			  offsets[chunk_id].value = count;
+			}, scheduler
+		  );
+		  // exclusive scan of the chunk counts
+		  std::size_t total{0};
+		  for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+		  {
+			const std::size_t count{offsets[chunk_id].value};
+			offsets[chunk_id].value = total;
+			total += count;
+		  }
+		  fork_join(plan, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  std::size_t true_offset{offsets[chunk_id].value};
+			  // everything before this chunk that did not match
+			  std::size_t false_offset{start - true_offset};
+			  for(std::size_t op = start; op < stop; ++op)
+				if(flags[op])
+				  *(output_true + true_offset++) = *(first + op);
+				else if(write_false)
+				  *(output_false + false_offset++) = *(first + op);
+			}, scheduler
+		  );
+		  return total;
+		}
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{ return copy_if(first, last, output_first, pred, auto_schedule(sizeof(typename std::iterator_traits<InputIt>::value_type)), scheduler); }
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, const schedule & policy, thread_pool::scheduler & scheduler)
+		{ return output_first + compact_chunks(first, std::distance(first, last), output_first, output_first, pred, true, false, policy, scheduler); }
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt remove_copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{ return remove_copy_if(first, last, output_first, pred, auto_schedule(sizeof(typename std::iterator_traits<InputIt>::value_type)), scheduler); }
+
+	  template <class InputIt, class OutputIt, class UnaryPredicate>
+		HOST OutputIt remove_copy_if(InputIt first, InputIt last, OutputIt output_first, UnaryPredicate pred, const schedule & policy, thread_pool::scheduler & scheduler)
+		{ return output_first + compact_chunks(first, std::distance(first, last), output_first, output_first, pred, false, false, policy, scheduler); }
+
+	  template <class InputIt, class OutputIt1, class OutputIt2, class UnaryPredicate>
+		HOST std::pair<OutputIt1, OutputIt2> partition_copy(InputIt first, InputIt last, OutputIt1 output_true, OutputIt2 output_false, UnaryPredicate pred,
+		                                                     thread_pool::scheduler & scheduler)
+		{ return partition_copy(first, last, output_true, output_false, pred, auto_schedule(sizeof(typename std::iterator_traits<InputIt>::value_type)), scheduler); }
+
+	  template <class InputIt, class OutputIt1, class OutputIt2, class UnaryPredicate>
+		HOST std::pair<OutputIt1, OutputIt2> partition_copy(InputIt first, InputIt last, OutputIt1 output_true, OutputIt2 output_false, UnaryPredicate pred,
+		                                                     const schedule & policy, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t n_true{compact_chunks(first, n_elements, output_true, output_false, pred, true, true, policy, scheduler)};
+		  return std::make_pair(output_true + n_true, output_false + (n_elements - n_true));
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,245 @@
+#ifndef ZINHART_EXPRESSION_TCC
+#define ZINHART_EXPRESSION_TCC
+#include <algorithm>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class RandomIt>
+		HOST terminal_expression<RandomIt>::terminal_expression(RandomIt first, const std::size_t n_elements)
+		  : first(first), n_elements(n_elements)
+		{}
+
+	  template <class RandomIt>
+		HOST auto terminal_expression<RandomIt>::operator[](const std::size_t i)const -> decltype(*std::declval<RandomIt>())
+		{ return *(first + i); }
+
+	  template <class RandomIt>
+		HOST std::size_t terminal_expression<RandomIt>::size()const
+		{ return n_elements; }
+
+	  template <class RandomIt>
+		HOST std::size_t terminal_expression<RandomIt>::bytes_per_element()const
+		{ return sizeof(value_type); }
+
+	  template <class T>
+		HOST scalar_expression<T>::scalar_expression(const T & value)
+		  : value(value)
+		{}
+
+	  template <class T>
+		HOST const T & scalar_expression<T>::operator[](const std::size_t i)const
+		{ return value; }
+
+	  template <class T>
+		HOST std::size_t scalar_expression<T>::size()const
+		{ return std::numeric_limits<std::size_t>::max(); }
+
+	  template <class T>
+		HOST std::size_t scalar_expression<T>::bytes_per_element()const
+		{ return 0; }
+
+	  template <class UnaryOperation, class Expression>
+		HOST unary_expression<UnaryOperation, Expression>::unary_expression(const Expression & operand, UnaryOperation op)
+		  : operand(operand), op(op)
+		{}
+
+	  template <class UnaryOperation, class Expression>
+		HOST typename unary_expression<UnaryOperation, Expression>::value_type unary_expression<UnaryOperation, Expression>::operator[](const std::size_t i)const
+		{ return op(operand[i]); }
+
+	  template <class UnaryOperation, class Expression>
+		HOST std::size_t unary_expression<UnaryOperation, Expression>::size()const
+		{ return operand.size(); }
+
+	  template <class UnaryOperation, class Expression>
+		HOST std::size_t unary_expression<UnaryOperation, Expression>::bytes_per_element()const
+		{ return operand.bytes_per_element(); }
+
+	  template <class BinaryOperation, class Left, class Right>
+		HOST binary_expression<BinaryOperation, Left, Right>::binary_expression(const Left & left, const Right & right, BinaryOperation op)
+		  : left(left), right(right), op(op)
+		{}
+
+	  template <class BinaryOperation, class Left, class Right>
+		HOST typename binary_expression<BinaryOperation, Left, Right>::value_type binary_expression<BinaryOperation, Left, Right>::operator[](const std::size_t i)const
+		{ return op(left[i], right[i]); }
+
+	  template <class BinaryOperation, class Left, class Right>
+		HOST std::size_t binary_expression<BinaryOperation, Left, Right>::size()const
+		{ return std::min(left.size(), right.size()); }
+
+	  template <class BinaryOperation, class Left, class Right>
+		HOST std::size_t binary_expression<BinaryOperation, Left, Right>::bytes_per_element()const
+		{ return left.bytes_per_element() + right.bytes_per_element(); }
+
+	  template <class RandomIt>
+		HOST terminal_expression<RandomIt> lazy(RandomIt first, RandomIt last)
+		{ return terminal_expression<RandomIt>(first, std::distance(first, last)); }
+
+	  template <class Left, class Right, class>
+		HOST binary_expression<add_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator + (const Left & left, const Right & right)
+		{
+		  return binary_expression<add_op, typename as_expression<Left>::type, typename as_expression<Right>::type>(as_expression<Left>::wrap(left), as_expression<Right>::wrap(right), add_op());
+		}
+
+	  template <class Left, class Right, class>
+		HOST binary_expression<subtract_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator - (const Left & left, const Right & right)
+		{
+		  return binary_expression<subtract_op, typename as_expression<Left>::type, typename as_expression<Right>::type>(as_expression<Left>::wrap(left), as_expression<Right>::wrap(right), subtract_op());
+		}
+
+	  template <class Left, class Right, class>
+		HOST binary_expression<multiply_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator * (const Left & left, const Right & right)
+		{
+		  return binary_expression<multiply_op, typename as_expression<Left>::type, typename as_expression<Right>::type>(as_expression<Left>::wrap(left), as_expression<Right>::wrap(right), multiply_op());
+		}
+
+	  template <class Left, class Right, class>
+		HOST binary_expression<divide_op, typename as_expression<Left>::type, typename as_expression<Right>::type> operator / (const Left & left, const Right & right)
+		{
+		  return binary_expression<divide_op, typename as_expression<Left>::type, typename as_expression<Right>::type>(as_expression<Left>::wrap(left), as_expression<Right>::wrap(right), divide_op());
+		}
+
+	  template <class Expression, class>
+		HOST unary_expression<negate_op, Expression> operator - (const Expression & operand)
+		{ return unary_expression<negate_op, Expression>(operand, negate_op()); }
+
+	  template <class UnaryOperation>
+		HOST map_adaptor<UnaryOperation>::map_adaptor(UnaryOperation op)
+		  : op(op)
+		{}
+
+	  template <class UnaryOperation>
+		HOST const UnaryOperation & map_adaptor<UnaryOperation>::get_op()const
+		{ return op; }
+
+	  template <class UnaryOperation>
+		HOST map_adaptor<UnaryOperation> map(UnaryOperation op)
+		{ return map_adaptor<UnaryOperation>(op); }
+
+	  template <class Expression, class UnaryOperation, class>
+		HOST unary_expression<UnaryOperation, Expression> operator | (const Expression & expression, const map_adaptor<UnaryOperation> & adaptor)
+		{ return unary_expression<UnaryOperation, Expression>(expression, adaptor.get_op()); }
+
+	  template <class Expression, class OutputIt, class>
+		HOST OutputIt store(const Expression & expression, OutputIt output_first, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements{expression.size()};
+		  fork_join(n_elements, auto_schedule(expression.bytes_per_element() + sizeof(typename Expression::value_type)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+				*(output_first + op) = expression[op];
+			}, scheduler
+		  );
+		  return output_first + n_elements;
+		}
+
+	  template <class Expression, class T, class BinaryOperation, class>
+		HOST T fold(const Expression & expression, T init, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements{expression.size()};
+		  if(n_elements == 0)
+			return init;
+		  return op(init, reduce_chunks<T>(n_elements, expression.bytes_per_element(), [&](std::size_t start, std::size_t stop)
+			{
+			  T partial = expression[start];
+			  for(std::size_t op_id = start + 1; op_id < stop; ++op_id)
+				partial = op(partial, expression[op_id]);
+			  return partial;
+			}, op, scheduler)
+		  );
+		}
+
+	  template <class Expression, class T, class>
+		HOST T sum(const Expression & expression, T init, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements{expression.size()};
+		  if(n_elements == 0)
+			return init;
+		  return init + reduce_chunks<T>(n_elements, expression.bytes_per_element(), [&](std::size_t start, std::size_t stop)
+			{
+			  // independent partials the compiler can keep in one register
+			  const std::size_t n_partials{8};
+			  T partials[n_partials] = {};
+			  std::size_t op{start};
+			  for(; op + n_partials <= stop; op += n_partials)
+				for(std::size_t i = 0; i < n_partials; ++i)
+				  partials[i] = partials[i] + expression[op + i];
+			  for(; op < stop; ++op)
+				partials[0] = partials[0] + expression[op];
+			  for(std::size_t width = n_partials / 2; width > 0; width /= 2)
+				for(std::size_t i = 0; i < width; ++i)
+				  partials[i] = partials[i] + partials[i + width];
+			  return partials[0];
+			}, std::plus<T>(), scheduler
+		  );
+		}
+
+	  template <class OutputIt>
+		HOST store_adaptor<OutputIt>::store_adaptor(OutputIt output_first, thread_pool::scheduler & scheduler)
+		  : output_first(output_first), scheduler(&scheduler)
+		{}
+
+	  template <class OutputIt>
+		template <class Expression>
+		  HOST OutputIt store_adaptor<OutputIt>::operator()(const Expression & expression)const
+		  { return store(expression, output_first, *scheduler); }
+
+	  template <class T, class BinaryOperation>
+		HOST fold_adaptor<T, BinaryOperation>::fold_adaptor(const T & init, BinaryOperation op, thread_pool::scheduler & scheduler)
+		  : init(init), op(op), scheduler(&scheduler)
+		{}
+
+	  template <class T, class BinaryOperation>
+		template <class Expression>
+		  HOST T fold_adaptor<T, BinaryOperation>::operator()(const Expression & expression)const
+		  { return fold(expression, init, op, *scheduler); }
+
+	  template <class T>
+		HOST sum_adaptor<T>::sum_adaptor(const T & init, thread_pool::scheduler & scheduler)
+		  : init(init), scheduler(&scheduler)
+		{}
+
+	  template <class T>
+		template <class Expression>
+		  HOST T sum_adaptor<T>::operator()(const Expression & expression)const
+		  { return sum(expression, init, *scheduler); }
+
+	  template <class Expression>
+		HOST typename Expression::value_type sum_adaptor<void>::operator()(const Expression & expression)const
+		{ return sum(expression, typename Expression::value_type{}, *scheduler); }
+
+	  template <class OutputIt>
+		HOST store_adaptor<OutputIt> store(OutputIt output_first, thread_pool::scheduler & scheduler)
+		{ return store_adaptor<OutputIt>(output_first, scheduler); }
+
+	  template <class T, class BinaryOperation>
+		HOST fold_adaptor<T, BinaryOperation> fold(T init, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{ return fold_adaptor<T, BinaryOperation>(init, op, scheduler); }
+
+	  template <class T>
+		HOST sum_adaptor<T> sum(thread_pool::scheduler & scheduler)
+		{ return sum_adaptor<T>(scheduler); }
+
+	  template <class T>
+		HOST sum_adaptor<T> sum(T init, thread_pool::scheduler & scheduler)
+		{ return sum_adaptor<T>(init, scheduler); }
+
+	  template <class Expression, class OutputIt, class>
+		HOST OutputIt operator | (const Expression & expression, const store_adaptor<OutputIt> & adaptor)
+		{ return adaptor(expression); }
+
+	  template <class Expression, class T, class BinaryOperation, class>
+		HOST T operator | (const Expression & expression, const fold_adaptor<T, BinaryOperation> & adaptor)
+		{ return adaptor(expression); }
+
+	  template <class Expression, class T, class>
+		HOST auto operator | (const Expression & expression, const sum_adaptor<T> & adaptor) -> decltype(adaptor(expression))
+		{ return adaptor(expression); }
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,111 @@
+#ifndef ZINHART_FORK_JOIN_TCC
+#define ZINHART_FORK_JOIN_TCC
+#include <algorithm>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  // shared between the calling thread and the workers of a fork_join,
+	  // workers that start after every chunk has been claimed only touch next_chunk and n_chunks
+	  template <class Body>
+		class fork_join_state
+		{
+		  public:
+			HOST fork_join_state(Body & body, const chunk_plan & plan)
+			  : body(body), plan(plan), n_chunks(plan.size()), next_chunk(0), finished_chunks(0)
+			{}
+			HOST fork_join_state(const fork_join_state&) = delete;
+			HOST fork_join_state & operator =(const fork_join_state&) = delete;
+			// claims chunks until there are none left
+			HOST void work()
+			{
+			  std::size_t chunk_id{0}, start{0}, stop{0};
+			  while((chunk_id = next_chunk.fetch_add(1)) < n_chunks)
+			  {
+				plan.range(chunk_id, start, stop);
+				try
+				{
+				  body(chunk_id, start, stop);
+				}
+				catch(...)
+				{
+				  std::lock_guard<std::mutex> local_lock(lock);
+				  if(!error)
+					error = std::current_exception();
+				}
+				if(finished_chunks.fetch_add(1) + 1 == n_chunks)
+				{
+				  std::lock_guard<std::mutex> local_lock(lock);
+				  cv.notify_all();
+				}
+			  }
+			}
+			// blocks until every chunk has finished, which only depends on chunks that are already running
+			HOST void wait()
+			{
+			  std::unique_lock<std::mutex> local_lock(lock);
+			  cv.wait(local_lock, [this](){ return finished_chunks.load() == n_chunks; });
+			  if(error)
+				std::rethrow_exception(error);
+			}
+		  private:
+			// body and plan are owned by the caller of fork_join, which does not return while a chunk is running
+			Body & body;
+			const chunk_plan & plan;
+			const std::size_t n_chunks;
+			std::atomic<std::size_t> next_chunk;
+			std::atomic<std::size_t> finished_chunks;
+			std::mutex lock;
+			std::condition_variable cv;
+			std::exception_ptr error;
+		};
+
+	  template <class Body>
+		class fork_join_worker
+		{
+		  public:
+			HOST fork_join_worker() = default;
+			HOST fork_join_worker(const std::shared_ptr<fork_join_state<Body>> & state)
+			  : state(state)
+			{}
+			HOST void operator()()
+			{ state->work(); }
+		  private:
+			std::shared_ptr<fork_join_state<Body>> state;
+		};
+
+	  template <class Body>
+		HOST void fork_join(const chunk_plan & plan, Body body, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t chunks{plan.size()};
+		  if(chunks == 0)
+			return;
+		  // nothing to share
+		  if(chunks == 1)
+		  {
+			body(0, 0, plan.get_n_elements());
+			return;
+		  }
+		  std::shared_ptr<fork_join_state<Body>> state{std::make_shared<fork_join_state<Body>>(body, plan)};
+		  scheduler.add_batch(static_cast<std::uint32_t>(std::min(chunks - 1, std::size_t{scheduler.size()})), fork_join_worker<Body>(state));
+		  state->work();
+		  state->wait();
+		}
+
+	  template <class Body>
+		HOST void fork_join(const std::size_t n_elements, const std::size_t n_chunks, Body body, thread_pool::scheduler & scheduler)
+		{ fork_join(chunk_plan(schedule(schedule_kind::static_chunks), n_elements, n_chunks), body, scheduler); }
+
+	  template <class Body>
+		HOST void fork_join(const std::size_t n_elements, Body body, thread_pool::scheduler & scheduler)
+		{ fork_join(n_elements, default_chunks(n_elements, scheduler), body, scheduler); }
+
+	  template <class Body>
+		HOST void fork_join(const std::size_t n_elements, const schedule & policy, Body body, thread_pool::scheduler & scheduler)
+		{ fork_join(chunk_plan(policy, n_elements, scheduler.size() + 1), body, scheduler); }
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
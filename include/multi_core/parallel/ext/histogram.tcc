@@ -0,0 +1,111 @@
+#ifndef ZINHART_HISTOGRAM_TCC
+#define ZINHART_HISTOGRAM_TCC
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class BinFunction>
+		HOST std::size_t histogram_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, BinFunction bin, std::size_t * counts, const std::size_t n_bins,
+		                                  thread_pool::scheduler & scheduler)
+		{
+		  std::fill(counts, counts + n_bins, std::size_t{0});
+		  if(n_elements == 0 || n_bins == 0)
+			return 0;
+		  const std::size_t n_chunks{auto_chunks(n_elements, bytes_per_element, scheduler)};
+		  // skipped elements land in an extra bin past the end so the counting loop has no branch
+		  const std::size_t padded_bins{n_bins + 1};
+		  if(n_chunks == 1 || n_bins * sizeof(std::size_t) > private_histogram_bytes)
+		  {
+			if(n_chunks == 1)
+			{
+			  std::vector<std::size_t> bins(padded_bins);
+			  for(std::size_t op = 0; op < n_elements; ++op)
+				++bins[bin(op)];
+			  std::copy(bins.begin(), bins.begin() + n_bins, counts);
+			  return n_elements - bins[n_bins];
+			}
+			std::vector<std::atomic<std::size_t>> bins(padded_bins);
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				for(std::size_t op = start; op < stop; ++op)
+				  bins[bin(op)].fetch_add(1, std::memory_order_relaxed);
+			  }, scheduler
+			);
+			// the join orders every increment before these loads
+			for(std::size_t i = 0; i < n_bins; ++i)
+			  counts[i] = bins[i].load(std::memory_order_relaxed);
+			return n_elements - bins[n_bins].load(std::memory_order_relaxed);
+		  }
+		  // each copy starts on its own cache line and is followed by a line of padding
+		  const std::size_t line_counts{CACHE_LINE_SIZE / sizeof(std::size_t)};
+		  const std::size_t stride{(padded_bins + line_counts - 1) / line_counts * line_counts + line_counts};
+		  std::vector<std::size_t> copies(n_chunks * stride + line_counts);
+		  const std::size_t offset{(CACHE_LINE_SIZE - reinterpret_cast<std::uintptr_t>(copies.data()) % CACHE_LINE_SIZE) % CACHE_LINE_SIZE / sizeof(std::size_t)};
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  std::size_t * bins{copies.data() + offset + chunk_id * stride};
+			  for(std::size_t op = start; op < stop; ++op)
+				++bins[bin(op)];
+			}, scheduler
+		  );
+		  // merge bin by bin, each chunk of bins reads every copy and writes its own part of counts
+		  fork_join(padded_bins, auto_schedule(n_chunks * sizeof(std::size_t)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t copy = 0; copy < n_chunks; ++copy)
+			  {
+				const std::size_t * bins{copies.data() + offset + copy * stride};
+				for(std::size_t i = start; i < std::min(stop, n_bins); ++i)
+				  counts[i] += bins[i];
+			  }
+			}, scheduler
+		  );
+		  std::size_t skipped{0};
+		  for(std::size_t copy = 0; copy < n_chunks; ++copy)
+			skipped += copies[offset + copy * stride + n_bins];
+		  return n_elements - skipped;
+		}
+
+	  template <class InputIt>
+		HOST std::size_t bincount(InputIt first, InputIt last, std::size_t * counts, const std::size_t n_bins, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  static_assert(std::is_integral<value_type>::value, "bincount counts integers, use histogram for floating point values");
+		  return histogram_chunks(std::distance(first, last), sizeof(value_type), [&](std::size_t i)
+			{
+			  const value_type value = *(first + i);
+			  return (value >= 0 && static_cast<std::uint64_t>(value) < n_bins) ? static_cast<std::size_t>(value) : n_bins;
+			}, counts, n_bins, scheduler
+		  );
+		}
+
+	  template <class InputIt, class T>
+		HOST std::size_t histogram(InputIt first, InputIt last, const T lower, const T upper, std::size_t * counts, const std::size_t n_bins, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  // integer bounds or elements must not divide or truncate in their own type
+		  using real = typename std::common_type<value_type, T, double>::type;
+		  const real real_lower{static_cast<real>(lower)}, real_upper{static_cast<real>(upper)};
+		  // written so that nan bounds fail the test
+		  if(!(real_lower < real_upper))
+			throw std::invalid_argument("histogram: upper must be greater than lower");
+		  const real scale{static_cast<real>(n_bins) / (real_upper - real_lower)};
+		  return histogram_chunks(std::distance(first, last), sizeof(value_type), [&](std::size_t i)
+			{
+			  const real value = static_cast<real>(*(first + i));
+			  // written so that nan fails the test
+			  if(!(value >= real_lower && value <= real_upper))
+				return n_bins;
+			  // rounding can push values just below upper into bin n_bins
+			  return std::min(static_cast<std::size_t>((value - real_lower) * scale), n_bins - 1);
+			}, counts, n_bins, scheduler
+		  );
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -7,30 +7,33 @@ namespace zinhart
 	{
 	  template <class precision_type> 
 		HOST void saxpy(const precision_type & a, precision_type * x, precision_type * y, 
-			            const std::uint32_t n_elements, const std::uint32_t n_threads, const std::uint32_t thread_id
+			            const std::size_t n_elements, const std::uint32_t n_threads, const std::uint32_t thread_id
 					   )
 		{
-	  	  std::uint32_t  start{0}, stop{0}, op{0};
+	  	  std::size_t start{0}, stop{0}, op{0};
 		  zinhart::multi_core::map(thread_id, n_threads, n_elements, start, stop);
 		  for(op = start; op < stop; ++op)
 			y[op] = a * x[op] + y[op];
 		}
 	  
 	  template<class precision_type>
-		HOST void copy(precision_type * in, precision_type * out, const std::uint32_t n_elements, const std::uint32_t n_threads, const std::uint32_t thread_id)
+		HOST void copy(precision_type * in, precision_type * out, const std::size_t n_elements, const std::uint32_t n_threads, const std::uint32_t thread_id)
 		{
-	  	  std::uint32_t  start{0}, stop{0}, op{0};
+	  	  std::size_t start{0}, stop{0};
 		  zinhart::multi_core::map(thread_id, n_threads, n_elements, start, stop);
-		  for(op = start; op < stop; ++op)
-			*(out + op) = *(in + op);
+		  // decided on the whole output so every thread agrees, each thread fences its own streaming stores
+		  if(zinhart::multi_core::simd::use_streaming_stores(n_elements * sizeof(precision_type)))
+			zinhart::multi_core::simd::stream_copy(in + start, out + start, stop - start);
+		  else
+			zinhart::multi_core::simd::copy(in + start, out + start, stop - start);
 		}
     
 	  template<class precision_type, class UnaryPredicate>
 		HOST void copy_if(const precision_type * const in, precision_type * out, UnaryPredicate pred,
-			              const std::uint32_t n_elements, const std::uint32_t n_threads, const std::uint32_t thread_id
+			              const std::size_t n_elements, const std::uint32_t n_threads, const std::uint32_t thread_id
 						 )
 		{
-		  std::uint32_t  start{0}, stop{0}, op{0};
+		  std::size_t start{0}, stop{0}, op{0};
 		  zinhart::multi_core::map(thread_id, n_threads, n_elements, start, stop);
 		  for(op = start; op < stop; ++op)
 			if(pred( *(in + op) ))
@@ -43,7 +46,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::replace<ForwardIt, T>, std::ref(first), old_value, new_value, thread_id, n_elements, thread_pool.size() )
@@ -55,7 +58,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::replace_if<ForwardIt, UnaryPredicate, T>,std::ref(first), std::ref(unary_predicate), std::ref(new_value), thread_id, n_elements, thread_pool.size() )
@@ -68,7 +71,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::replace_copy<InputIt, OutputIt, T>, std::ref(first), std::ref(output_it), std::ref(old_value), std::ref(new_value), thread_id, n_elements, thread_pool.size() )
@@ -82,7 +85,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::replace_copy_if<InputIt, OutputIt, UnaryPredicate, T>, std::ref(first), std::ref(output_it),std::ref(unary_predicate), std::ref(new_value), thread_id, n_elements, thread_pool.size() )
@@ -94,7 +97,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::inner_product<InputIt1, InputIt2, T>, std::ref(first), std::ref(output_it), std::ref(value), thread_id, n_elements, thread_pool.size()  )
@@ -106,7 +109,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first1, last1);
+		  const std::size_t n_elements = std::distance(first1, last1);
 	  	  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			  results.push_back(
 			  thread_pool.add_task(zinhart::multi_core::vectorized::inner_product<InputIt1, InputIt2, T, BinaryOperation1, BinaryOperation2>, std::ref(first1), std::ref(first2), std::ref(value), op1, op2, thread_id, n_elements, thread_pool.size()  )
@@ -118,7 +121,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::accumulate<InputIt, T>, std::ref(first), std::ref(init), thread_id, n_elements, thread_pool.size())
@@ -130,7 +133,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::for_each<InputIt, UnaryFunction>, std::ref(first), std::ref(f), thread_id, n_elements, thread_pool.size())
@@ -142,7 +145,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 		  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::transform<InputIt, OutputIt, UnaryOperation>,  std::ref(first), std::ref(output_first), std::ref(unary_op), thread_id, n_elements, thread_pool.size() )
@@ -154,7 +157,7 @@ namespace zinhart
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 	  	  //to identify each thread
 		  std::uint32_t thread_id = 0;
-		  const std::uint32_t n_elements = std::distance(first, last);
+		  const std::size_t n_elements = std::distance(first, last);
 		  for(thread_id = 0; thread_id < thread_pool.size(); ++thread_id)
 			results.push_back(
 			thread_pool.add_task(zinhart::multi_core::vectorized::generate<BidirectionalIt, Generator>, std::ref(first), std::ref(g), thread_id, n_elements, thread_pool.size())
@@ -162,7 +165,7 @@ namespace zinhart
 		}
 
 	  template <class precision_type, class container>
-		HOST void kahan_sum(const precision_type * data, const std::uint32_t & data_size, precision_type & global_sum, container & results, thread_pool::pool & thread_pool)
+		HOST void kahan_sum(const precision_type * data, const std::size_t & data_size, precision_type & global_sum, container & results, thread_pool::pool & thread_pool)
 		{
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 	  	  //to identify each thread
@@ -173,7 +176,7 @@ namespace zinhart
 			);
 		}
 	  template <class precision_type, class container>
-		HOST void neumaier_sum(const precision_type * data, const std::uint32_t & data_size, precision_type & global_sum, container & results, thread_pool::pool & thread_pool)
+		HOST void neumaier_sum(const precision_type * data, const std::size_t & data_size, precision_type & global_sum, container & results, thread_pool::pool & thread_pool)
 		{
 		  static_assert(std::is_same<typename container::value_type, zinhart::multi_core::thread_pool::tasks::task_future<void> >::value, "container value_type must be zinhart::multi_core::thread_pool::tasks::task_future<void>\n");
 	  	  //to identify each thread
@@ -184,7 +187,7 @@ namespace zinhart
 			);
 		}
   	  template <class precision_type, class container, class binary_predicate>
-  		HOST void kahan_sum(const precision_type * vec_1, const precision_type * vec_2, const std::uint32_t & data_size, 
+  		HOST void kahan_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t & data_size, 
 							precision_type & global_sum, 
 							binary_predicate bp, 
 							container & results, thread_pool::pool & thread_pool
@@ -200,7 +203,7 @@ namespace zinhart
 		}
   
 	  template <class precision_type, class container, class binary_predicate>
-  		HOST void neumaier_sum(const precision_type * vec_1, const precision_type * vec_2, const std::uint32_t & data_size, 
+  		HOST void neumaier_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t & data_size, 
 							   precision_type & global_sum,
 							   binary_predicate bp,
 							   container & results, thread_pool::pool & thread_pool
@@ -0,0 +1,128 @@
+#ifndef ZINHART_RADIX_SORT_TCC
+#define ZINHART_RADIX_SORT_TCC
+#include <algorithm>
+#include <cstring>
+#include <utility>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class Key>
+		HOST typename radix_traits<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type>::bits_type
+		radix_traits<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type>::encode(const Key key)
+		{
+		  const bits_type sign_bit{bits_type(1) << (8 * sizeof(Key) - 1)};
+		  bits_type bits{0};
+		  std::memcpy(&bits, &key, sizeof(Key));
+		  return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+		}
+
+	  template <class Key, class Value>
+		HOST void radix_sort_pairs(Key * keys, Value * values, const std::size_t n_elements, Key * key_buffer, Value * value_buffer, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t radix_bits{8};
+		  const std::size_t buckets{1 << radix_bits};
+		  const std::size_t n_chunks{auto_chunks(n_elements, sizeof(Key), scheduler)};
+		  if(n_elements < 2)
+			return;
+		  // one histogram per chunk, after the scan each entry is where that chunk writes its next key with that digit
+		  std::vector<std::size_t> histograms(n_chunks * buckets);
+		  Key * key_source{keys}, * key_destination{key_buffer};
+		  Value * value_source{values}, * value_destination{value_buffer};
+		  for(std::size_t shift = 0; shift < 8 * sizeof(Key); shift += radix_bits)
+		  {
+			auto digit = [shift, buckets](const Key key)
+			{ return static_cast<std::size_t>((radix_traits<Key>::encode(key) >> shift) & (buckets - 1)); };
+			std::fill(histograms.begin(), histograms.end(), 0);
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				std::size_t * histogram{histograms.data() + chunk_id * buckets};
+				for(std::size_t i = start; i < stop; ++i)
+				  ++histogram[digit(key_source[i])];
+			  }, scheduler
+			);
+			// every key has the same digit, the pass would be a copy
+			const std::size_t first_digit{digit(key_source[0])};
+			std::size_t first_digit_count{0};
+			for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+			  first_digit_count += histograms[chunk_id * buckets + first_digit];
+			if(first_digit_count == n_elements)
+			  continue;
+			// digit major exclusive scan, chunk order within a digit keeps the pass stable
+			std::size_t offset{0};
+			for(std::size_t d = 0; d < buckets; ++d)
+			  for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+			  {
+				const std::size_t count{histograms[chunk_id * buckets + d]};
+				histograms[chunk_id * buckets + d] = offset;
+				offset += count;
+			  }
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				std::size_t * offsets{histograms.data() + chunk_id * buckets};
+				for(std::size_t i = start; i < stop; ++i)
+				{
+				  const std::size_t position{offsets[digit(key_source[i])]++};
+				  key_destination[position] = key_source[i];
+				  if(values)
+					value_destination[position] = value_source[i];
+				}
+			  }, scheduler
+			);
+			std::swap(key_source, key_destination);
+			std::swap(value_source, value_destination);
+		  }
+		  // an odd number of passes ran
+		  if(key_source != keys)
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				std::copy(key_source + start, key_source + stop, keys + start);
+				if(values)
+				  std::copy(value_source + start, value_source + stop, values + start);
+			  }, scheduler
+			);
+		}
+
+	  template <class Key>
+		HOST void radix_sort(Key * keys, const std::size_t n_elements, thread_pool::scheduler & scheduler)
+		{
+		  std::vector<Key> key_buffer(n_elements);
+		  radix_sort(keys, n_elements, key_buffer.data(), scheduler);
+		}
+
+	  template <class Key>
+		HOST void radix_sort(Key * keys, const std::size_t n_elements, Key * key_buffer, thread_pool::scheduler & scheduler)
+		{ radix_sort_pairs(keys, static_cast<Key*>(nullptr), n_elements, key_buffer, static_cast<Key*>(nullptr), scheduler); }
+
+	  template <class Key, class Value>
+		HOST void sort_by_key(Key * keys, Value * values, const std::size_t n_elements, thread_pool::scheduler & scheduler)
+		{
+		  std::vector<Key> key_buffer(n_elements);
+		  std::vector<Value> value_buffer(n_elements);
+		  radix_sort_pairs(keys, values, n_elements, key_buffer.data(), value_buffer.data(), scheduler);
+		}
+
+	  template <class Key, class Value>
+		HOST void sort_by_key(Key * keys, Value * values, const std::size_t n_elements, Key * key_buffer, Value * value_buffer, thread_pool::scheduler & scheduler)
+		{ radix_sort_pairs(keys, values, n_elements, key_buffer, value_buffer, scheduler); }
+
+	  template <class Key>
+		HOST void argsort(const Key * keys, const std::size_t n_elements, std::size_t * indices, thread_pool::scheduler & scheduler)
+		{
+		  std::vector<Key> key_copy(n_elements), key_buffer(n_elements);
+		  std::vector<std::size_t> index_buffer(n_elements);
+		  fork_join(n_elements, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  std::copy(keys + start, keys + stop, key_copy.begin() + start);
+			  for(std::size_t i = start; i < stop; ++i)
+				indices[i] = i;
+			}, scheduler
+		  );
+		  radix_sort_pairs(key_copy.data(), indices, n_elements, key_buffer.data(), index_buffer.data(), scheduler);
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
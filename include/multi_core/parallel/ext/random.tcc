@@ -0,0 +1,120 @@
+#ifndef ZINHART_RANDOM_TCC
+#define ZINHART_RANDOM_TCC
+#include <cmath>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace random
+	{
+	  // the top 24 bits of a word
+	  template <>
+		class variates<float>
+		{
+		  public:
+			static constexpr std::size_t words{1};
+			// [0, 1)
+			HOST static float closed_open(const std::uint32_t * bits)
+			{ return static_cast<float>(bits[0] >> 8) * (1.0f / 16777216.0f); }
+			// (0, 1], safe to take the log of
+			HOST static float open_closed(const std::uint32_t * bits)
+			{ return static_cast<float>((bits[0] >> 8) + 1) * (1.0f / 16777216.0f); }
+		};
+
+	  // the top 53 bits of two words, low word first
+	  template <>
+		class variates<double>
+		{
+		  public:
+			static constexpr std::size_t words{2};
+			HOST static double closed_open(const std::uint32_t * bits)
+			{ return static_cast<double>((std::uint64_t{bits[1]} << 32 | bits[0]) >> 11) * (1.0 / 9007199254740992.0); }
+			HOST static double open_closed(const std::uint32_t * bits)
+			{ return static_cast<double>(((std::uint64_t{bits[1]} << 32 | bits[0]) >> 11) + 1) * (1.0 / 9007199254740992.0); }
+		};
+
+	  template <class precision_type>
+		HOST uniform_real<precision_type>::uniform_real(const precision_type a, const precision_type b)
+		  : lower(a), range(b - a)
+		{}
+
+	  template <class precision_type>
+		HOST precision_type uniform_real<precision_type>::a()const
+		{ return lower; }
+
+	  template <class precision_type>
+		HOST precision_type uniform_real<precision_type>::b()const
+		{ return lower + range; }
+
+	  template <class precision_type>
+		HOST void uniform_real<precision_type>::operator()(const std::uint32_t * bits, precision_type * values, const std::size_t n_blocks)const
+		{
+		  for(std::size_t i = 0; i < n_blocks * values_per_block; ++i)
+			values[i] = lower + range * variates<precision_type>::closed_open(bits + i * variates<precision_type>::words);
+		}
+
+	  template <class precision_type>
+		HOST normal<precision_type>::normal(const precision_type mean, const precision_type stddev)
+		  : mu(mean), sigma(stddev)
+		{}
+
+	  template <class precision_type>
+		HOST precision_type normal<precision_type>::mean()const
+		{ return mu; }
+
+	  template <class precision_type>
+		HOST precision_type normal<precision_type>::stddev()const
+		{ return sigma; }
+
+	  template <class precision_type>
+		HOST void normal<precision_type>::operator()(const std::uint32_t * bits, precision_type * values, const std::size_t n_blocks)const
+		{
+		  const std::size_t words{variates<precision_type>::words};
+		  const precision_type two_pi{static_cast<precision_type>(6.283185307179586476925286766559)};
+		  for(std::size_t i = 0; i < n_blocks * values_per_block; i += 2)
+		  {
+			const std::uint32_t * pair{bits + i * words};
+			const precision_type radius{sigma * std::sqrt(precision_type{-2} * std::log(variates<precision_type>::open_closed(pair)))};
+			const precision_type angle{two_pi * variates<precision_type>::closed_open(pair + words)};
+			values[i] = mu + radius * std::cos(angle);
+			values[i + 1] = mu + radius * std::sin(angle);
+		  }
+		}
+	}// END NAMESPACE RANDOM
+
+	namespace parallel
+	{
+	  template <class RandomIt, class Distribution>
+		HOST void generate_random(RandomIt first, RandomIt last, const Distribution & distribution, const random::philox4x32 & engine, thread_pool::scheduler & scheduler)
+		{
+		  using result_type = typename Distribution::result_type;
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t per_block{Distribution::values_per_block};
+		  const bool streaming{simd::use_streaming_stores(n_elements * sizeof(typename std::iterator_traits<RandomIt>::value_type))};
+		  fork_join(n_elements, auto_schedule(sizeof(result_type)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  // 4 KiB of bits and of values, both stay in l1
+			  const std::size_t staged_blocks{256};
+			  std::uint32_t bits[staged_blocks * random::philox4x32::block_words];
+			  result_type values[staged_blocks * Distribution::values_per_block];
+			  for(std::size_t op = start; op < stop;)
+			  {
+				// a chunk may start and end part way through a block, the unused values are dropped
+				const std::size_t skip{op % per_block};
+				const std::size_t n_blocks{std::min(staged_blocks, (stop - op + skip + per_block - 1) / per_block)};
+				engine.blocks(op / per_block, bits, n_blocks);
+				distribution(bits, values, n_blocks);
+				const std::size_t count{std::min(n_blocks * per_block - skip, stop - op)};
+				if(streaming)
+				  simd::stream_copy(values + skip, first + op, count);
+				else
+				  simd::copy(values + skip, first + op, count);
+				op += count;
+			  }
+			}, scheduler
+		  );
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,232 @@
+#ifndef ZINHART_REDUCE_TCC
+#define ZINHART_REDUCE_TCC
+#include <cmath>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class precision_type>
+		HOST compensated<precision_type> compensated_add(const compensated<precision_type> & x, const compensated<precision_type> & y)
+		{
+		  const precision_type sum{x.sum + y.sum};
+		  const precision_type y_part{sum - x.sum};
+		  const precision_type error{(x.sum - (sum - y_part)) + (y.sum - y_part)};
+		  return compensated<precision_type>{sum, x.correction + y.correction + error};
+		}
+
+	  template <class T, class BinaryOperation>
+		HOST T tree_combine(std::vector<padded_partial<T>> & partials, BinaryOperation op)
+		{
+		  for(std::size_t stride = 1; stride < partials.size(); stride *= 2)
+			for(std::size_t i = 0; i + stride < partials.size(); i += 2 * stride)
+			  partials[i].value = op(partials[i].value, partials[i + stride].value);
+		  return partials[0].value;
+		}
+
+	  template <class T, class ChunkReduction, class BinaryOperation>
+		HOST T reduce_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, ChunkReduction chunk, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_chunks{auto_chunks(n_elements, bytes_per_element, scheduler)};
+		  std::vector<padded_partial<T>> partials(n_chunks);
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{ partials[chunk_id].value = chunk(start, stop); }, scheduler
+		  );
+		  return tree_combine(partials, op);
+		}
+
+	  template <class InputIt, class T>
+		HOST T reduce(InputIt first, InputIt last, T init, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return init;
+		  // plain sums of float or double arrays run on the simd kernels
+		  return init + reduce_chunks<T>(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{ return simd::accumulate(first + start + 1, stop - start - 1, T(*(first + start))); }, std::plus<T>(), scheduler
+		  );
+		}
+
+	  template <class InputIt, class T, class BinaryOperation>
+		HOST T reduce(InputIt first, InputIt last, T init, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return init;
+		  return op(init, reduce_chunks<T>(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{
+			  T partial = *(first + start);
+			  for(std::size_t op_id = start + 1; op_id < stop; ++op_id)
+				partial = op(partial, *(first + op_id));
+			  return partial;
+			}, op, scheduler)
+		  );
+		}
+
+	  template <class InputIt, class T, class BinaryOperation, class UnaryOperation>
+		HOST T transform_reduce(InputIt first, InputIt last, T init, BinaryOperation reduce_op, UnaryOperation transform_op, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return init;
+		  return reduce_op(init, reduce_chunks<T>(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{
+			  T partial = transform_op( *(first + start) );
+			  for(std::size_t op = start + 1; op < stop; ++op)
+				partial = reduce_op(partial, transform_op( *(first + op) ));
+			  return partial;
+			}, reduce_op, scheduler)
+		  );
+		}
+
+	  template <class InputIt1, class InputIt2, class T, class BinaryOperation1, class BinaryOperation2>
+		HOST T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, BinaryOperation1 reduce_op, BinaryOperation2 transform_op, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first1, last1);
+		  if(n_elements == 0)
+			return init;
+		  const std::size_t bytes_per_element = sizeof(typename std::iterator_traits<InputIt1>::value_type) + sizeof(typename std::iterator_traits<InputIt2>::value_type);
+		  return reduce_op(init, reduce_chunks<T>(n_elements, bytes_per_element, [&](std::size_t start, std::size_t stop)
+			{
+			  T partial = transform_op( *(first1 + start), *(first2 + start) );
+			  for(std::size_t op = start + 1; op < stop; ++op)
+				partial = reduce_op(partial, transform_op( *(first1 + op), *(first2 + op) ));
+			  return partial;
+			}, reduce_op, scheduler)
+		  );
+		}
+
+	  template <class InputIt1, class InputIt2, class T>
+		HOST T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first1, last1);
+		  if(n_elements == 0)
+			return init;
+		  const std::size_t bytes_per_element = sizeof(typename std::iterator_traits<InputIt1>::value_type) + sizeof(typename std::iterator_traits<InputIt2>::value_type);
+		  return init + reduce_chunks<T>(n_elements, bytes_per_element, [&](std::size_t start, std::size_t stop)
+			{ return simd::inner_product(first1 + start + 1, first2 + start + 1, stop - start - 1, T(*(first1 + start) * *(first2 + start))); }, std::plus<T>(), scheduler
+		  );
+		}
+
+	  template <class InputIt1, class InputIt2, class T, class BinaryOperation1, class BinaryOperation2>
+		HOST T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, BinaryOperation1 op1, BinaryOperation2 op2, thread_pool::scheduler & scheduler)
+		{ return transform_reduce(first1, last1, first2, init, op1, op2, scheduler); }
+
+	  // a single compensated chain in index order, reproducible_sum and the compensated scan rely on it
+	  template <class precision_type, class Element>
+		HOST compensated<precision_type> neumaier_chunk(Element element, const std::size_t start, const std::size_t stop)
+		{
+		  precision_type sum{element(start)};
+		  // a running compensation for lost lower-order bits
+		  precision_type compensation{0.0};
+		  for(std::size_t op = start + 1; op < stop; ++op)
+		  {
+			const precision_type x{element(op)};
+			const precision_type t{sum + x};
+			if(std::abs(sum) >= std::abs(x))
+			  // if the sum is bigger lower order digits of x are lost
+			  compensation += (sum - t) + x;
+			else
+			  // if the sum is smaller lower order digits of sum are lost
+			  compensation += (x - t) + sum;
+			sum = t;
+		  }
+		  return compensated<precision_type>{sum, compensation};
+		}
+
+	  template <class precision_type>
+		HOST precision_type kahan_sum(const precision_type * data, const std::size_t data_size, thread_pool::scheduler & scheduler)
+		{
+		  if(data_size == 0)
+			return precision_type{0};
+		  // each chunk runs the lane parallel simd kernel and hands back its sum and correction unrounded, the chunks are merged with compensated adds
+		  const compensated<precision_type> total = reduce_chunks<compensated<precision_type>>(data_size, sizeof(precision_type), [&](std::size_t start, std::size_t stop)
+			{
+			  compensated<precision_type> partial;
+			  partial.sum = simd::kahan_sum(data + start, stop - start, partial.correction);
+			  return partial;
+			}, compensated_add<precision_type>, scheduler
+		  );
+		  return total.sum + total.correction;
+		}
+
+	  template <class precision_type>
+		HOST precision_type neumaier_sum(const precision_type * data, const std::size_t data_size, thread_pool::scheduler & scheduler)
+		{
+		  if(data_size == 0)
+			return precision_type{0};
+		  // each chunk runs the lane parallel simd kernel and hands back its sum and correction unrounded, the chunks are merged with compensated adds
+		  const compensated<precision_type> total = reduce_chunks<compensated<precision_type>>(data_size, sizeof(precision_type), [&](std::size_t start, std::size_t stop)
+			{
+			  compensated<precision_type> partial;
+			  partial.sum = simd::neumaier_sum(data + start, stop - start, partial.correction);
+			  return partial;
+			}, compensated_add<precision_type>, scheduler
+		  );
+		  return total.sum + total.correction;
+		}
+
+	  template <class precision_type, class binary_predicate>
+		HOST precision_type kahan_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t data_size, binary_predicate bp, thread_pool::scheduler & scheduler)
+		{
+		  if(data_size == 0)
+			return precision_type{0};
+		  const compensated<precision_type> total = reduce_chunks<compensated<precision_type>>(data_size, 2 * sizeof(precision_type), [&](std::size_t start, std::size_t stop)
+			{
+			  auto element = [vec_1, vec_2, start, &bp](std::size_t i){ return precision_type(bp(vec_1[start + i], vec_2[start + i])); };
+			  compensated<precision_type> partial;
+			  partial.sum = zinhart::multi_core::kahan_lanes<precision_type>(element, stop - start, partial.correction);
+			  return partial;
+			}, compensated_add<precision_type>, scheduler
+		  );
+		  return total.sum + total.correction;
+		}
+
+	  template <class precision_type, class binary_predicate>
+		HOST precision_type neumaier_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t data_size, binary_predicate bp, thread_pool::scheduler & scheduler)
+		{
+		  if(data_size == 0)
+			return precision_type{0};
+		  const compensated<precision_type> total = reduce_chunks<compensated<precision_type>>(data_size, 2 * sizeof(precision_type), [&](std::size_t start, std::size_t stop)
+			{
+			  auto element = [vec_1, vec_2, start, &bp](std::size_t i){ return precision_type(bp(vec_1[start + i], vec_2[start + i])); };
+			  compensated<precision_type> partial;
+			  partial.sum = zinhart::multi_core::neumaier_lanes<precision_type>(element, stop - start, partial.correction);
+			  return partial;
+			}, compensated_add<precision_type>, scheduler
+		  );
+		  return total.sum + total.correction;
+		}
+
+	  template <class precision_type, class Element>
+		HOST precision_type reproducible_sum_blocks(Element element, const std::size_t data_size, thread_pool::scheduler & scheduler)
+		{
+		  if(data_size == 0)
+			return precision_type{0};
+		  const std::size_t n_blocks{(data_size + reproducible_block_size - 1) / reproducible_block_size};
+		  std::vector<compensated<precision_type>> block_sums(n_blocks);
+		  // chunks only decide who sums a block, never which elements go in it
+		  fork_join(n_blocks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t block = start; block < stop; ++block)
+				block_sums[block] = neumaier_chunk<precision_type>(element, block * reproducible_block_size, std::min(data_size, (block + 1) * reproducible_block_size));
+			}, scheduler
+		  );
+		  for(std::size_t stride = 1; stride < n_blocks; stride *= 2)
+			for(std::size_t i = 0; i + stride < n_blocks; i += 2 * stride)
+			  block_sums[i] = compensated_add(block_sums[i], block_sums[i + stride]);
+		  return block_sums[0].sum + block_sums[0].correction;
+		}
+
+	  template <class precision_type>
+		HOST precision_type reproducible_sum(const precision_type * data, const std::size_t data_size, thread_pool::scheduler & scheduler)
+		{ return reproducible_sum_blocks<precision_type>([data](std::size_t i){ return data[i]; }, data_size, scheduler); }
+
+	  template <class precision_type, class binary_predicate>
+		HOST precision_type reproducible_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t data_size, binary_predicate bp, thread_pool::scheduler & scheduler)
+		{ return reproducible_sum_blocks<precision_type>([vec_1, vec_2, &bp](std::size_t i){ return precision_type(bp(vec_1[i], vec_2[i])); }, data_size, scheduler); }
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,170 @@
+#ifndef ZINHART_SCAN_TCC
+#define ZINHART_SCAN_TCC
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class T, class InputIt, class OutputIt, class BinaryOperation, class UnaryOperation>
+		HOST OutputIt scan_chunks(InputIt first, const std::size_t n_elements, OutputIt output_first, BinaryOperation op, UnaryOperation unary_op,
+		                          const bool exclusive, const bool has_init, const T & init, thread_pool::scheduler & scheduler)
+		{
+		  if(n_elements == 0)
+			return output_first;
+		  const std::size_t n_chunks{auto_chunks(n_elements, sizeof(T), scheduler)};
+		  std::vector<padded_partial<T>> partials(n_chunks);
+		  // the last chunk's total is never a carry
+		  if(n_chunks > 1)
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				if(chunk_id + 1 == n_chunks)
+				  return;
+				T partial = unary_op( *(first + start) );
+				for(std::size_t i = start + 1; i < stop; ++i)
+				  partial = op(partial, unary_op( *(first + i) ));
+				partials[chunk_id].value = partial;
+			  }, scheduler
+			);
+		  // turn the chunk totals into the carry into each chunk, chunk 0 only has a carry when there is an init
+		  T carry{has_init ? init : T{}};
+		  bool has_carry{has_init};
+		  for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+		  {
+			const T total = partials[chunk_id].value;
+			partials[chunk_id].value = carry;
+			carry = has_carry ? op(carry, total) : total;
+			has_carry = true;
+		  }
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  std::size_t i{start};
+			  T running;
+			  if(chunk_id > 0 || has_init)
+				running = partials[chunk_id].value;
+			  else
+			  {
+				running = unary_op( *(first + i) );
+				*(output_first + i) = running;
+				++i;
+			  }
+			  if(exclusive)
+				for(; i < stop; ++i)
+				{
+				  // read before writing so output_first may alias first
+				  const T value = unary_op( *(first + i) );
+				  *(output_first + i) = running;
+				  running = op(running, value);
+				}
+			  else
+				for(; i < stop; ++i)
+				{
+				  running = op(running, unary_op( *(first + i) ));
+				  *(output_first + i) = running;
+				}
+			}, scheduler
+		  );
+		  return output_first + n_elements;
+		}
+
+	  // passes values through unchanged for the scans that have no transform
+	  template <class T>
+		class identity_transform
+		{
+		  public:
+			HOST const T & operator()(const T & value)const
+			{ return value; }
+		};
+
+	  template <class InputIt, class OutputIt>
+		HOST OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt output_first, thread_pool::scheduler & scheduler)
+		{
+		  using T = typename std::iterator_traits<InputIt>::value_type;
+		  return scan_chunks<T>(first, std::distance(first, last), output_first, std::plus<T>(), identity_transform<T>(), false, false, T{}, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt, class BinaryOperation>
+		HOST OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{
+		  using T = typename std::iterator_traits<InputIt>::value_type;
+		  return scan_chunks<T>(first, std::distance(first, last), output_first, op, identity_transform<T>(), false, false, T{}, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt, class BinaryOperation, class T>
+		HOST OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, T init, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  return scan_chunks<T>(first, std::distance(first, last), output_first, op, identity_transform<value_type>(), false, true, init, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt, class T>
+		HOST OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt output_first, T init, thread_pool::scheduler & scheduler)
+		{ return exclusive_scan(first, last, output_first, init, std::plus<T>(), scheduler); }
+
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt output_first, T init, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  return scan_chunks<T>(first, std::distance(first, last), output_first, op, identity_transform<value_type>(), true, true, init, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt, class BinaryOperation, class UnaryOperation>
+		HOST OutputIt transform_inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, UnaryOperation unary_op, thread_pool::scheduler & scheduler)
+		{
+		  using T = typename std::decay<decltype(unary_op(*first))>::type;
+		  return scan_chunks<T>(first, std::distance(first, last), output_first, op, unary_op, false, false, T{}, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt, class BinaryOperation, class UnaryOperation, class T>
+		HOST OutputIt transform_inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, UnaryOperation unary_op, T init, thread_pool::scheduler & scheduler)
+		{ return scan_chunks<T>(first, std::distance(first, last), output_first, op, unary_op, false, true, init, scheduler); }
+
+	  template <class precision_type>
+		HOST precision_type * compensated_inclusive_scan(const precision_type * data, const std::size_t data_size, precision_type * output, thread_pool::scheduler & scheduler)
+		{
+		  if(data_size == 0)
+			return output;
+		  const std::size_t n_chunks{auto_chunks(data_size, sizeof(precision_type), scheduler)};
+		  std::vector<padded_partial<compensated<precision_type>>> partials(n_chunks);
+		  // adds x with an exact two-sum, then folds the correction back into the sum with another,
+		  // so the correction stays below an ulp of the sum and its own rounding cannot build up over a long chunk
+		  auto add = [](compensated<precision_type> & running, const precision_type x)
+		  {
+			running = compensated_add(running, compensated<precision_type>{x, 0});
+			running = compensated_add(compensated<precision_type>{running.sum, 0}, compensated<precision_type>{running.correction, 0});
+		  };
+		  if(n_chunks > 1)
+			fork_join(data_size, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				if(chunk_id + 1 < n_chunks)
+				{
+				  compensated<precision_type> running{0, 0};
+				  for(std::size_t i = start; i < stop; ++i)
+					add(running, data[i]);
+				  partials[chunk_id].value = running;
+				}
+			  }, scheduler
+			);
+		  compensated<precision_type> carry{0, 0};
+		  for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+		  {
+			const compensated<precision_type> total = partials[chunk_id].value;
+			partials[chunk_id].value = carry;
+			carry = compensated_add(carry, total);
+		  }
+		  fork_join(data_size, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  compensated<precision_type> running = partials[chunk_id].value;
+			  for(std::size_t i = start; i < stop; ++i)
+			  {
+				add(running, data[i]);
+				output[i] = running.sum;
+			  }
+			}, scheduler
+		  );
+		  return output + data_size;
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,155 @@
+#ifndef ZINHART_SEARCH_TCC
+#define ZINHART_SEARCH_TCC
+#include <algorithm>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class Predicate>
+		HOST std::size_t find_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, Predicate pred, const bool lowest, thread_pool::scheduler & scheduler)
+		{
+		  // dynamic chunks are claimed in element order, so the chunks that can hold the lowest match run first
+		  const std::size_t grain{std::max(search_block, min_bytes_per_task / std::max(bytes_per_element, std::size_t{1}))};
+		  std::atomic<std::size_t> bound{n_elements};
+		  fork_join(n_elements, schedule(schedule_kind::dynamic_chunks, grain), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t block_start = start; block_start < stop; block_start += search_block)
+			  {
+				const std::size_t known{bound.load(std::memory_order_relaxed)};
+				if(lowest ? known <= block_start : known != n_elements)
+				  return;
+				const std::size_t block_stop{std::min(block_start + search_block, stop)};
+				for(std::size_t op = block_start; op < block_stop; ++op)
+				  if(pred(op))
+				  {
+					std::size_t current{bound.load(std::memory_order_relaxed)};
+					while(op < current && !bound.compare_exchange_weak(current, op, std::memory_order_relaxed))
+					  ;
+					return;
+				  }
+			  }
+			}, scheduler
+		  );
+		  return bound.load(std::memory_order_relaxed);
+		}
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST InputIt find_if(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  return first + find_chunks(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t i){ return bool(pred(*(first + i))); }, true, scheduler);
+		}
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST InputIt find_if_not(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  return first + find_chunks(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t i){ return !pred(*(first + i)); }, true, scheduler);
+		}
+
+	  template <class InputIt, class T>
+		HOST InputIt find(InputIt first, InputIt last, const T & value, thread_pool::scheduler & scheduler)
+		{ return find_if(first, last, [&value](const typename std::iterator_traits<InputIt>::value_type & element){ return element == value; }, scheduler); }
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST bool any_of(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  return find_chunks(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t i){ return bool(pred(*(first + i))); }, false, scheduler) != n_elements;
+		}
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST bool all_of(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  return find_chunks(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t i){ return !pred(*(first + i)); }, false, scheduler) == n_elements;
+		}
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST bool none_of(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{ return !any_of(first, last, pred, scheduler); }
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST typename std::iterator_traits<InputIt>::difference_type count_if(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return 0;
+		  return reduce_chunks<std::size_t>(n_elements, sizeof(typename std::iterator_traits<InputIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{
+			  std::size_t matches{0};
+			  for(std::size_t op = start; op < stop; ++op)
+				matches += pred(*(first + op)) ? 1 : 0;
+			  return matches;
+			}, std::plus<std::size_t>(), scheduler
+		  );
+		}
+
+	  template <class InputIt, class T>
+		HOST typename std::iterator_traits<InputIt>::difference_type count(InputIt first, InputIt last, const T & value, thread_pool::scheduler & scheduler)
+		{ return count_if(first, last, [&value](const typename std::iterator_traits<InputIt>::value_type & element){ return element == value; }, scheduler); }
+
+	  template <class ForwardIt>
+		HOST ForwardIt min_element(ForwardIt first, ForwardIt last, thread_pool::scheduler & scheduler)
+		{ return min_element(first, last, std::less<typename std::iterator_traits<ForwardIt>::value_type>(), scheduler); }
+
+	  template <class ForwardIt, class Compare>
+		HOST ForwardIt min_element(ForwardIt first, ForwardIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return last;
+		  // partials are positions and the left one comes from the lower chunk, it keeps ties
+		  return first + reduce_chunks<std::size_t>(n_elements, sizeof(typename std::iterator_traits<ForwardIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{ return std::size_t(std::distance(first, std::min_element(first + start, first + stop, comp))); },
+			[&](std::size_t left, std::size_t right){ return comp(*(first + right), *(first + left)) ? right : left; }, scheduler
+		  );
+		}
+
+	  template <class ForwardIt>
+		HOST ForwardIt max_element(ForwardIt first, ForwardIt last, thread_pool::scheduler & scheduler)
+		{ return max_element(first, last, std::less<typename std::iterator_traits<ForwardIt>::value_type>(), scheduler); }
+
+	  template <class ForwardIt, class Compare>
+		HOST ForwardIt max_element(ForwardIt first, ForwardIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return last;
+		  return first + reduce_chunks<std::size_t>(n_elements, sizeof(typename std::iterator_traits<ForwardIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{ return std::size_t(std::distance(first, std::max_element(first + start, first + stop, comp))); },
+			[&](std::size_t left, std::size_t right){ return comp(*(first + left), *(first + right)) ? right : left; }, scheduler
+		  );
+		}
+
+	  template <class ForwardIt>
+		HOST std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first, ForwardIt last, thread_pool::scheduler & scheduler)
+		{ return minmax_element(first, last, std::less<typename std::iterator_traits<ForwardIt>::value_type>(), scheduler); }
+
+	  template <class ForwardIt, class Compare>
+		HOST std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first, ForwardIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  if(n_elements == 0)
+			return std::make_pair(last, last);
+		  using positions = std::pair<std::size_t, std::size_t>;
+		  const positions extremes{reduce_chunks<positions>(n_elements, sizeof(typename std::iterator_traits<ForwardIt>::value_type), [&](std::size_t start, std::size_t stop)
+			{
+			  const std::pair<ForwardIt, ForwardIt> chunk_extremes{std::minmax_element(first + start, first + stop, comp)};
+			  return positions(std::distance(first, chunk_extremes.first), std::distance(first, chunk_extremes.second));
+			},
+			// the lower chunk keeps tied minimums and the higher chunk tied maximums
+			[&](const positions & left, const positions & right)
+			{
+			  return positions(comp(*(first + right.first), *(first + left.first)) ? right.first : left.first,
+			                   comp(*(first + right.second), *(first + left.second)) ? left.second : right.second);
+			}, scheduler
+		  )};
+		  return std::make_pair(first + extremes.first, first + extremes.second);
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,261 @@
+#ifndef ZINHART_SEGMENTED_TCC
+#define ZINHART_SEGMENTED_TCC
+#include <algorithm>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2>
+		HOST std::pair<OutputIt1, OutputIt2> reduce_by_key(InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first, OutputIt1 keys_output, OutputIt2 values_output,
+		                                                   thread_pool::scheduler & scheduler)
+		{
+		  using key_type = typename std::iterator_traits<InputIt1>::value_type;
+		  using value_type = typename std::iterator_traits<InputIt2>::value_type;
+		  return reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, std::equal_to<key_type>(), std::plus<value_type>(), scheduler);
+		}
+
+	  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2, class BinaryPredicate>
+		HOST std::pair<OutputIt1, OutputIt2> reduce_by_key(InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first, OutputIt1 keys_output, OutputIt2 values_output,
+		                                                   BinaryPredicate pred, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<InputIt2>::value_type;
+		  return reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, pred, std::plus<value_type>(), scheduler);
+		}
+
+	  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2, class BinaryPredicate, class BinaryOperation>
+		HOST std::pair<OutputIt1, OutputIt2> reduce_by_key(InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first, OutputIt1 keys_output, OutputIt2 values_output,
+		                                                   BinaryPredicate pred, BinaryOperation op, thread_pool::scheduler & scheduler)
+		{
+		  using key_type = typename std::iterator_traits<InputIt1>::value_type;
+		  using value_type = typename std::iterator_traits<InputIt2>::value_type;
+		  const std::size_t n_elements = std::distance(keys_first, keys_last);
+		  if(n_elements == 0)
+			return std::make_pair(keys_output, values_output);
+		  // element i starts a segment when its key differs from the one before it
+		  auto head = [&](std::size_t i){ return i == 0 || !pred(*(keys_first + (i - 1)), *(keys_first + i)); };
+		  const std::size_t n_chunks{auto_chunks(n_elements, sizeof(key_type) + sizeof(value_type), scheduler)};
+		  // what a chunk leaves for the calling thread, the piece before its first head and the segment still open at its end
+		  struct chunk_state
+		  {
+			std::size_t first_slot;
+			bool has_leading;
+			value_type leading;
+			bool has_tail;
+			std::size_t tail_slot;
+			std::size_t tail_head;
+			value_type tail;
+		  };
+		  std::vector<padded_partial<chunk_state>> states(n_chunks);
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  std::size_t heads{0};
+			  for(std::size_t op_id = start; op_id < stop; ++op_id)
+				heads += head(op_id);
+			  states[chunk_id].value.first_slot = heads;
+			}, scheduler
+		  );
+		  std::size_t n_segments{0};
+		  for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+		  {
+			const std::size_t heads{states[chunk_id].value.first_slot};
+			states[chunk_id].value.first_slot = n_segments;
+			n_segments += heads;
+		  }
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  chunk_state & state = states[chunk_id].value;
+			  std::size_t op_id{start};
+			  state.has_leading = !head(start);
+			  if(state.has_leading)
+			  {
+				state.leading = *(values_first + op_id);
+				for(++op_id; op_id < stop && !head(op_id); ++op_id)
+				  state.leading = op(state.leading, *(values_first + op_id));
+			  }
+			  state.has_tail = op_id < stop;
+			  std::size_t slot{state.first_slot};
+			  while(op_id < stop)
+			  {
+				const std::size_t segment_head{op_id};
+				value_type partial = *(values_first + op_id);
+				for(++op_id; op_id < stop && !head(op_id); ++op_id)
+				  partial = op(partial, *(values_first + op_id));
+				if(op_id < stop)
+				{
+				  *(keys_output + slot) = *(keys_first + segment_head);
+				  *(values_output + slot) = partial;
+				  ++slot;
+				}
+				else
+				{
+				  state.tail_slot = slot;
+				  state.tail_head = segment_head;
+				  state.tail = partial;
+				}
+			  }
+			}, scheduler
+		  );
+		  // join the segments that cross chunk boundaries in chunk order, element 0 is a head so chunk 0 opens the first one
+		  std::size_t open_slot{0}, open_head{0};
+		  value_type open = states[0].value.tail;
+		  for(std::size_t chunk_id = 0; chunk_id < n_chunks; ++chunk_id)
+		  {
+			const chunk_state & state = states[chunk_id].value;
+			if(state.has_leading)
+			  open = op(open, state.leading);
+			if(state.has_tail)
+			{
+			  if(chunk_id > 0)
+			  {
+				*(keys_output + open_slot) = *(keys_first + open_head);
+				*(values_output + open_slot) = open;
+			  }
+			  open_slot = state.tail_slot;
+			  open_head = state.tail_head;
+			  open = state.tail;
+			}
+		  }
+		  *(keys_output + open_slot) = *(keys_first + open_head);
+		  *(values_output + open_slot) = open;
+		  return std::make_pair(keys_output + n_segments, values_output + n_segments);
+		}
+
+	  template <class InputIt, class OutputIt, class T, class LineReduction, class BinaryOperation>
+		HOST OutputIt reduce_lines(InputIt matrix, const std::size_t n_lines, const std::size_t line_length, OutputIt output, const T & init, LineReduction line, BinaryOperation op,
+		                           thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t bytes_per_element{sizeof(typename std::iterator_traits<InputIt>::value_type)};
+		  const std::size_t line_chunks{auto_chunks(n_lines, line_length * bytes_per_element, scheduler)};
+		  const std::size_t element_chunks{auto_chunks(line_length, bytes_per_element, scheduler)};
+		  if(line_length == 0 || line_chunks >= element_chunks)
+		  {
+			fork_join(n_lines, line_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				for(std::size_t i = start; i < stop; ++i)
+				  *(output + i) = line(matrix + i * line_length, line_length, init);
+			  }, scheduler
+			);
+			return output + n_lines;
+		  }
+		  // too few lines to go around, every thread works on each line in turn
+		  for(std::size_t i = 0; i < n_lines; ++i)
+		  {
+			InputIt first{matrix + i * line_length};
+			*(output + i) = op(init, reduce_chunks<T>(line_length, bytes_per_element, [&](std::size_t start, std::size_t stop)
+			  { return line(first + start + 1, stop - start - 1, T(*(first + start))); }, op, scheduler)
+			);
+		  }
+		  return output + n_lines;
+		}
+
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt reduce_strided(InputIt matrix, const std::size_t depth, const std::size_t width, OutputIt output, const T & init, BinaryOperation op,
+		                             thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t bytes_per_element{sizeof(typename std::iterator_traits<InputIt>::value_type)};
+		  if(depth == 0)
+		  {
+			fork_join(width, auto_schedule(sizeof(T)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				for(std::size_t j = start; j < stop; ++j)
+				  *(output + j) = init;
+			  }, scheduler
+			);
+			return output + width;
+		  }
+		  // accumulates rows [first_row, last_row) of lines [first_line, last_line) into acc, a block of lines at a time so acc stays in the l1 cache
+		  auto accumulate_block = [&](T * acc, std::size_t first_row, std::size_t last_row, std::size_t first_line, std::size_t last_line)
+		  {
+			for(std::size_t block = first_line; block < last_line; block += column_block_size)
+			{
+			  const std::size_t block_stop{std::min(block + column_block_size, last_line)};
+			  InputIt row{matrix + first_row * width};
+			  for(std::size_t j = block; j < block_stop; ++j)
+				acc[j - first_line] = *(row + j);
+			  for(std::size_t i = first_row + 1; i < last_row; ++i)
+			  {
+				row = matrix + i * width;
+				for(std::size_t j = block; j < block_stop; ++j)
+				  acc[j - first_line] = op(acc[j - first_line], *(row + j));
+			  }
+			}
+		  };
+		  const std::size_t line_chunks{auto_chunks(width, depth * bytes_per_element, scheduler)};
+		  const std::size_t row_chunks{auto_chunks(depth, width * bytes_per_element, scheduler)};
+		  if(line_chunks >= row_chunks)
+		  {
+			// enough lines to split, each chunk owns its lines outright
+			fork_join(width, line_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				std::vector<T> acc(stop - start);
+				accumulate_block(acc.data(), 0, depth, start, stop);
+				for(std::size_t j = start; j < stop; ++j)
+				  *(output + j) = op(init, acc[j - start]);
+			  }, scheduler
+			);
+			return output + width;
+		  }
+		  // few long lines, each chunk of rows accumulates every line into its own partial and the partials are combined in row order
+		  const std::size_t stride{width + CACHE_LINE_SIZE / sizeof(T) + 1};
+		  std::vector<T> partials(row_chunks * stride);
+		  fork_join(depth, row_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{ accumulate_block(partials.data() + chunk_id * stride, start, stop, 0, width); }, scheduler
+		  );
+		  fork_join(width, auto_schedule(row_chunks * sizeof(T)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t j = start; j < stop; ++j)
+			  {
+				T result = op(init, partials[j]);
+				for(std::size_t copy = 1; copy < row_chunks; ++copy)
+				  result = op(result, partials[copy * stride + j]);
+				*(output + j) = result;
+			  }
+			}, scheduler
+		  );
+		  return output + width;
+		}
+
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt row_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init, BinaryOperation op,
+		                         thread_pool::scheduler & scheduler)
+		{
+		  if(layout == matrix_layout::column_major)
+			return reduce_strided(matrix, n_cols, n_rows, output, init, op, scheduler);
+		  return reduce_lines(matrix, n_rows, n_cols, output, init, [&](InputIt first, std::size_t n_elements, T partial)
+			{
+			  for(std::size_t i = 0; i < n_elements; ++i)
+				partial = op(partial, *(first + i));
+			  return partial;
+			}, op, scheduler
+		  );
+		}
+
+	  template <class InputIt, class OutputIt, class T>
+		HOST OutputIt row_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init,
+		                         thread_pool::scheduler & scheduler)
+		{
+		  if(layout == matrix_layout::column_major)
+			return reduce_strided(matrix, n_cols, n_rows, output, init, std::plus<T>(), scheduler);
+		  return reduce_lines(matrix, n_rows, n_cols, output, init, [](InputIt first, std::size_t n_elements, T partial)
+			{ return simd::accumulate(first, n_elements, partial); }, std::plus<T>(), scheduler
+		  );
+		}
+
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt col_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init, BinaryOperation op,
+		                         thread_pool::scheduler & scheduler)
+		{
+		  // a column of a row major matrix is a row of its column major transpose
+		  return row_reduce(matrix, (layout == matrix_layout::row_major) ? matrix_layout::column_major : matrix_layout::row_major, n_cols, n_rows, output, init, op, scheduler);
+		}
+
+	  template <class InputIt, class OutputIt, class T>
+		HOST OutputIt col_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init,
+		                         thread_pool::scheduler & scheduler)
+		{ return row_reduce(matrix, (layout == matrix_layout::row_major) ? matrix_layout::column_major : matrix_layout::row_major, n_cols, n_rows, output, init, scheduler); }
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
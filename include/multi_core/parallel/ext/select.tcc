@@ -0,0 +1,212 @@
+#ifndef ZINHART_SELECT_TCC
+#define ZINHART_SELECT_TCC
+#include <algorithm>
+#include <numeric>
+#include <random>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class RandomIt, class Compare>
+		HOST void sample_select(RandomIt first, RandomIt nth, RandomIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t target = std::distance(first, nth);
+		  if(target >= n_elements)
+			return;
+		  // the band [low, high) still holding the target
+		  std::size_t low{0}, high{n_elements};
+		  std::vector<value_type> buffer;
+		  // a fixed seed keeps the element order the same from run to run
+		  std::mt19937_64 engine(n_elements);
+		  std::vector<value_type> sample(select_sample_size);
+		  while(true)
+		  {
+			const std::size_t n_band{high - low};
+			const std::size_t n_chunks{auto_chunks(n_band, sizeof(value_type), scheduler)};
+			if(n_chunks <= 1 || n_band <= 4 * select_sample_size)
+			  break;
+			for(value_type & element : sample)
+			  element = *(first + low + engine() % n_band);
+			std::sort(sample.begin(), sample.end(), comp);
+			const std::size_t position{(target - low) * select_sample_size / n_band};
+			const value_type lower{sample[position > select_sample_margin ? position - select_sample_margin : 0]};
+			const value_type upper{sample[std::min(position + select_sample_margin, select_sample_size - 1)]};
+			// 0 below lower, 1 between the two, 2 above upper
+			auto band = [&](const value_type & element){ return comp(element, lower) ? 0 : (comp(upper, element) ? 2 : 1); };
+			std::vector<padded_partial<std::array<std::size_t, 3>>> offsets(n_chunks);
+			fork_join(n_band, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				std::array<std::size_t, 3> counts{{0, 0, 0}};
+				for(std::size_t op = low + start; op < low + stop; ++op)
+				  ++counts[band(*(first + op))];
+				offsets[chunk_id].value = counts;
+			  }, scheduler
+			);
+			// each chunk's counts become where its part of each band starts in the buffer
+			std::array<std::size_t, 3> totals{{0, 0, 0}};
+			for(std::size_t chunk = 0; chunk < n_chunks; ++chunk)
+			  for(std::size_t b = 0; b < 3; ++b)
+			  {
+				const std::size_t count{offsets[chunk].value[b]};
+				offsets[chunk].value[b] = totals[b];
+				totals[b] += count;
+			  }
+			if(buffer.empty())
+			  buffer.resize(n_elements);
+			fork_join(n_band, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				std::array<std::size_t, 3> next{{offsets[chunk_id].value[0], totals[0] + offsets[chunk_id].value[1], totals[0] + totals[1] + offsets[chunk_id].value[2]}};
+				for(std::size_t op = low + start; op < low + stop; ++op)
+				  buffer[next[band(*(first + op))]++] = std::move(*(first + op));
+			  }, scheduler
+			);
+			fork_join(n_band, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  { std::move(buffer.begin() + start, buffer.begin() + stop, first + low + start); }, scheduler
+			);
+			const std::size_t rank{target - low};
+			if(rank < totals[0])
+			  high = low + totals[0];
+			else if(rank < totals[0] + totals[1])
+			{
+			  // a band between equal splitters holds only copies of the target
+			  if(!comp(lower, upper))
+				return;
+			  high = low + totals[0] + totals[1];
+			  low += totals[0];
+			}
+			else
+			  low += totals[0] + totals[1];
+			// splitters at the ends of the band left it whole
+			if(high - low == n_band)
+			  break;
+		  }
+		  std::nth_element(first + low, nth, first + high, comp);
+		}
+
+	  template <class RandomIt>
+		HOST void nth_element(RandomIt first, RandomIt nth, RandomIt last, thread_pool::scheduler & scheduler)
+		{ sample_select(first, nth, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), scheduler); }
+
+	  template <class RandomIt, class Compare>
+		HOST void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{ sample_select(first, nth, last, comp, scheduler); }
+
+	  template <class RandomIt, class Compare>
+		HOST std::vector<std::pair<typename std::iterator_traits<RandomIt>::value_type, std::size_t>> smallest_k(RandomIt first, const std::size_t n_elements, const std::size_t k,
+		                                                                                                         Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+		  using entry = std::pair<value_type, std::size_t>;
+		  // smaller elements first and equal elements in order of position
+		  auto before = [&comp](const entry & a, const entry & b){ return comp(a.first, b.first) || (!comp(b.first, a.first) && a.second < b.second); };
+		  const std::size_t n_chunks{auto_chunks(n_elements, sizeof(value_type), scheduler)};
+		  std::vector<entry> candidates;
+		  // heaps pay off while their candidates are a small part of the input, otherwise every element is a candidate
+		  if(k * n_chunks * 8 <= n_elements)
+		  {
+			std::vector<padded_partial<std::vector<entry>>> heaps(n_chunks);
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				// the front of the heap is the kept element that comes last, positions only grow so an equal element never displaces it
+				std::vector<entry> heap;
+				heap.reserve(k);
+				std::size_t op{start};
+				for(; op < stop && heap.size() < k; ++op)
+				  heap.emplace_back(*(first + op), op);
+				std::make_heap(heap.begin(), heap.end(), before);
+				for(; op < stop; ++op)
+				  if(comp(*(first + op), heap.front().first))
+				  {
+					std::pop_heap(heap.begin(), heap.end(), before);
+					heap.back() = entry(*(first + op), op);
+					std::push_heap(heap.begin(), heap.end(), before);
+				  }
+				heaps[chunk_id].value.swap(heap);
+			  }, scheduler
+			);
+			for(std::size_t chunk = 0; chunk < n_chunks; ++chunk)
+			  candidates.insert(candidates.end(), heaps[chunk].value.begin(), heaps[chunk].value.end());
+		  }
+		  else
+		  {
+			candidates.resize(n_elements);
+			fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  {
+				for(std::size_t op = start; op < stop; ++op)
+				  candidates[op] = entry(*(first + op), op);
+			  }, scheduler
+			);
+		  }
+		  sample_select(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), before, scheduler);
+		  merge_sort(candidates.begin(), candidates.begin() + (k - 1), before, false, scheduler);
+		  candidates.resize(k);
+		  return candidates;
+		}
+
+	  template <class RandomIt>
+		HOST void partial_sort(RandomIt first, RandomIt middle, RandomIt last, thread_pool::scheduler & scheduler)
+		{ partial_sort(first, middle, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), scheduler); }
+
+	  template <class RandomIt, class Compare>
+		HOST void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t n_front = std::distance(first, middle);
+		  if(n_front == 0)
+			return;
+		  if(n_front * auto_chunks(n_elements, sizeof(typename std::iterator_traits<RandomIt>::value_type), scheduler) * 8 > n_elements)
+		  {
+			// the element before middle is the largest of the front
+			sample_select(first, middle - 1, last, comp, scheduler);
+			merge_sort(first, middle - 1, comp, false, scheduler);
+			return;
+		  }
+		  // a short front is picked out by the heaps, its elements outside the front trade places with the front elements that were not picked
+		  const auto selected = smallest_k(first, n_elements, n_front, comp, scheduler);
+		  std::vector<bool> picked(n_front, false);
+		  std::vector<std::size_t> outside;
+		  for(const auto & element : selected)
+			if(element.second < n_front)
+			  picked[element.second] = true;
+			else
+			  outside.push_back(element.second);
+		  for(std::size_t i = 0, j = 0; i < n_front; ++i)
+			if(!picked[i])
+			  *(first + outside[j++]) = std::move(*(first + i));
+		  for(std::size_t i = 0; i < n_front; ++i)
+			*(first + i) = selected[i].first;
+		}
+
+	  template <class RandomIt, class ValueIt, class IndexIt>
+		HOST std::size_t top_k(RandomIt first, RandomIt last, const std::size_t k, ValueIt values, IndexIt indices, thread_pool::scheduler & scheduler)
+		{ return top_k(first, last, k, values, indices, std::less<typename std::iterator_traits<RandomIt>::value_type>(), scheduler); }
+
+	  template <class RandomIt, class ValueIt, class IndexIt, class Compare>
+		HOST std::size_t top_k(RandomIt first, RandomIt last, const std::size_t k, ValueIt values, IndexIt indices, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t n_selected{std::min(k, n_elements)};
+		  if(n_selected == 0)
+			return 0;
+		  // the largest under comp are the smallest under the reversed comparison
+		  const auto selected = smallest_k(first, n_elements, n_selected, [&comp](const value_type & a, const value_type & b){ return comp(b, a); }, scheduler);
+		  fork_join(n_selected, auto_schedule(2 * sizeof(value_type) + sizeof(std::size_t)), [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  for(std::size_t op = start; op < stop; ++op)
+			  {
+				*(values + op) = selected[op].first;
+				*(indices + op) = selected[op].second;
+			  }
+			}, scheduler
+		  );
+		  return n_selected;
+		}
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,225 @@
+#ifndef ZINHART_SIMD_TCC
+#define ZINHART_SIMD_TCC
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace simd
+	{
+	  template <class precision_type, class InputIt, class OutputIt>
+		HOST void saxpy(const precision_type a, InputIt x, OutputIt y, const std::size_t n_elements, std::true_type)
+		{ saxpy(a, static_cast<const precision_type *>(x), static_cast<precision_type *>(y), n_elements); }
+
+	  template <class precision_type, class InputIt, class OutputIt>
+		HOST void saxpy(const precision_type a, InputIt x, OutputIt y, const std::size_t n_elements, std::false_type)
+		{
+		  for(std::size_t op = 0; op < n_elements; ++op)
+			*(y + op) = a * *(x + op) + *(y + op);
+		}
+
+	  template <class precision_type, class InputIt, class OutputIt>
+		HOST void saxpy(const precision_type a, InputIt x, OutputIt y, const std::size_t n_elements)
+		{
+		  saxpy(a, x, y, n_elements, std::integral_constant<bool, has_kernel<InputIt, precision_type>::value && has_kernel<OutputIt, precision_type>::value>());
+		}
+
+	  template <class InputIt, class OutputIt>
+		HOST void copy(InputIt x, OutputIt y, const std::size_t n_elements, std::true_type)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  copy(static_cast<const value_type *>(x), static_cast<value_type *>(y), n_elements);
+		}
+
+	  template <class InputIt, class OutputIt>
+		HOST void copy(InputIt x, OutputIt y, const std::size_t n_elements, std::false_type)
+		{ std::copy(x, x + n_elements, y); }
+
+	  template <class InputIt, class OutputIt>
+		HOST void copy(InputIt x, OutputIt y, const std::size_t n_elements)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  copy(x, y, n_elements, std::integral_constant<bool, has_kernel<InputIt, value_type>::value && has_kernel<OutputIt, value_type>::value>());
+		}
+
+	  template <class ForwardIt, class T>
+		HOST void replace(ForwardIt x, const std::size_t n_elements, const T & old_value, const T & new_value, std::true_type)
+		{ replace(static_cast<T *>(x), n_elements, old_value, new_value); }
+
+	  template <class ForwardIt, class T>
+		HOST void replace(ForwardIt x, const std::size_t n_elements, const T & old_value, const T & new_value, std::false_type)
+		{
+		  for(std::size_t op = 0; op < n_elements; ++op)
+			if(*(x + op) == old_value)
+			  *(x + op) = new_value;
+		}
+
+	  template <class ForwardIt, class T>
+		HOST void replace(ForwardIt x, const std::size_t n_elements, const T & old_value, const T & new_value)
+		{ replace(x, n_elements, old_value, new_value, std::integral_constant<bool, has_kernel<ForwardIt, T>::value>()); }
+
+	  template <class InputIt, class T>
+		HOST T accumulate(InputIt x, const std::size_t n_elements, T init, std::true_type)
+		{ return init + accumulate(static_cast<const T *>(x), n_elements); }
+
+	  template <class InputIt, class T>
+		HOST T accumulate(InputIt x, const std::size_t n_elements, T init, std::false_type)
+		{
+		  for(std::size_t op = 0; op < n_elements; ++op)
+			init = init + *(x + op);
+		  return init;
+		}
+
+	  template <class InputIt, class T>
+		HOST T accumulate(InputIt x, const std::size_t n_elements, T init)
+		{ return accumulate(x, n_elements, init, std::integral_constant<bool, has_kernel<InputIt, T>::value>()); }
+
+	  template <class InputIt1, class InputIt2, class T>
+		HOST T inner_product(InputIt1 x, InputIt2 y, const std::size_t n_elements, T init, std::true_type)
+		{ return init + inner_product(static_cast<const T *>(x), static_cast<const T *>(y), n_elements); }
+
+	  template <class InputIt1, class InputIt2, class T>
+		HOST T inner_product(InputIt1 x, InputIt2 y, const std::size_t n_elements, T init, std::false_type)
+		{
+		  for(std::size_t op = 0; op < n_elements; ++op)
+			init = init + *(x + op) * *(y + op);
+		  return init;
+		}
+
+	  template <class InputIt1, class InputIt2, class T>
+		HOST T inner_product(InputIt1 x, InputIt2 y, const std::size_t n_elements, T init)
+		{ return inner_product(x, y, n_elements, init, std::integral_constant<bool, has_kernel<InputIt1, T>::value && has_kernel<InputIt2, T>::value>()); }
+
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type kahan_sum(InputIt x, const std::size_t n_elements, std::true_type)
+		{ return kahan_sum(static_cast<const typename std::iterator_traits<InputIt>::value_type *>(x), n_elements); }
+
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type kahan_sum(InputIt x, const std::size_t n_elements, std::false_type)
+		{ return kahan_lanes<typename std::iterator_traits<InputIt>::value_type>([x](std::size_t i){ return *(x + i); }, n_elements); }
+
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type kahan_sum(InputIt x, const std::size_t n_elements)
+		{ return kahan_sum(x, n_elements, std::integral_constant<bool, has_kernel<InputIt, typename std::iterator_traits<InputIt>::value_type>::value>()); }
+
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type neumaier_sum(InputIt x, const std::size_t n_elements, std::true_type)
+		{ return neumaier_sum(static_cast<const typename std::iterator_traits<InputIt>::value_type *>(x), n_elements); }
+
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type neumaier_sum(InputIt x, const std::size_t n_elements, std::false_type)
+		{ return neumaier_lanes<typename std::iterator_traits<InputIt>::value_type>([x](std::size_t i){ return *(x + i); }, n_elements); }
+
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type neumaier_sum(InputIt x, const std::size_t n_elements)
+		{ return neumaier_sum(x, n_elements, std::integral_constant<bool, has_kernel<InputIt, typename std::iterator_traits<InputIt>::value_type>::value>()); }
+
+	  // elements reached through proxies have no address to prefetch
+	  template <int rw, class It>
+		HOST void prefetch_element(It it, std::true_type)
+		{ __builtin_prefetch(std::addressof(*it), rw); }
+
+	  template <int rw, class It>
+		HOST void prefetch_element(It it, std::false_type)
+		{}
+
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void gather(InputIt x, IndexIt index, OutputIt y, const std::size_t n_elements, std::true_type)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  using index_type = typename std::remove_cv<typename std::remove_pointer<IndexIt>::type>::type;
+		  using kernel_index = typename std::conditional<sizeof(index_type) == sizeof(std::int32_t), std::int32_t, std::int64_t>::type;
+		  gather(static_cast<const value_type *>(x), reinterpret_cast<const kernel_index *>(index), static_cast<value_type *>(y), n_elements);
+		}
+
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void gather(InputIt x, IndexIt index, OutputIt y, const std::size_t n_elements, std::false_type)
+		{
+		  std::integral_constant<bool, std::is_lvalue_reference<typename std::iterator_traits<InputIt>::reference>::value> addressable;
+		  std::size_t op{0};
+		  for(; op + prefetch_distance < n_elements; ++op)
+		  {
+			prefetch_element<0>(x + *(index + op + prefetch_distance), addressable);
+			*(y + op) = *(x + *(index + op));
+		  }
+		  for(; op < n_elements; ++op)
+			*(y + op) = *(x + *(index + op));
+		}
+
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void gather(InputIt x, IndexIt index, OutputIt y, const std::size_t n_elements)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  gather(x, index, y, n_elements, std::integral_constant<bool, has_kernel<InputIt, value_type>::value && has_kernel<OutputIt, value_type>::value && has_index_kernel<IndexIt>::value>());
+		}
+
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void scatter(InputIt x, IndexIt index, OutputIt y, const std::size_t n_elements)
+		{
+		  std::integral_constant<bool, std::is_lvalue_reference<typename std::iterator_traits<OutputIt>::reference>::value> addressable;
+		  std::size_t op{0};
+		  for(; op + prefetch_distance < n_elements; ++op)
+		  {
+			prefetch_element<1>(y + *(index + op + prefetch_distance), addressable);
+			*(y + *(index + op)) = *(x + op);
+		  }
+		  for(; op < n_elements; ++op)
+			*(y + *(index + op)) = *(x + op);
+		}
+
+	  template <class InputIt, class OutputIt>
+		HOST void stream_copy(InputIt x, OutputIt y, const std::size_t n_elements, std::true_type)
+		{ stream_copy_bytes(x, y, n_elements * sizeof(typename std::iterator_traits<InputIt>::value_type)); }
+
+	  template <class InputIt, class OutputIt>
+		HOST void stream_copy(InputIt x, OutputIt y, const std::size_t n_elements, std::false_type)
+		{ std::copy(x, x + n_elements, y); }
+
+	  template <class InputIt, class OutputIt>
+		HOST void stream_copy(InputIt x, OutputIt y, const std::size_t n_elements)
+		{
+		  using value_type = typename std::iterator_traits<InputIt>::value_type;
+		  stream_copy(x, y, n_elements, std::integral_constant<bool, can_stream<InputIt, value_type>::value && can_stream<OutputIt, value_type>::value>());
+		}
+
+	  template <class OutputIt, class T>
+		HOST void stream_fill(OutputIt x, const std::size_t n_elements, const T & value, std::true_type)
+		{ stream_fill_bytes(x, &value, sizeof(T), n_elements); }
+
+	  template <class OutputIt, class T>
+		HOST void stream_fill(OutputIt x, const std::size_t n_elements, const T & value, std::false_type)
+		{ std::fill(x, x + n_elements, value); }
+
+	  template <class OutputIt, class T>
+		HOST void stream_fill(OutputIt x, const std::size_t n_elements, const T & value)
+		{ stream_fill(x, n_elements, value, std::integral_constant<bool, can_stream<OutputIt, T>::value>()); }
+
+	  template <class OutputIt, class Generator>
+		HOST void stream_generate(OutputIt x, const std::size_t n_elements, Generator g, std::true_type)
+		{
+		  using value_type = typename std::iterator_traits<OutputIt>::value_type;
+		  // small enough to stay in l1
+		  const std::size_t block_size{std::max(std::size_t{4096} / sizeof(value_type), std::size_t{1})};
+		  std::vector<value_type> block(std::min(block_size, n_elements));
+		  for(std::size_t start = 0; start < n_elements; start += block_size)
+		  {
+			const std::size_t count{std::min(block_size, n_elements - start)};
+			for(std::size_t i = 0; i < count; ++i)
+			  block[i] = g();
+			stream_copy_bytes(block.data(), x + start, count * sizeof(value_type));
+		  }
+		}
+
+	  template <class OutputIt, class Generator>
+		HOST void stream_generate(OutputIt x, const std::size_t n_elements, Generator g, std::false_type)
+		{
+		  for(std::size_t op = 0; op < n_elements; ++op)
+			*(x + op) = g();
+		}
+
+	  template <class OutputIt, class Generator>
+		HOST void stream_generate(OutputIt x, const std::size_t n_elements, Generator g)
+		{ stream_generate(x, n_elements, g, std::integral_constant<bool, can_stream<OutputIt, typename std::iterator_traits<OutputIt>::value_type>::value>()); }
+	}// END NAMESPACE SIMD
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
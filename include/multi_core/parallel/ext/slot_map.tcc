@@ -0,0 +1,135 @@
+#ifndef SLOT_MAP_TCC
+#define SLOT_MAP_TCC
+#include <new>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	template <class T>
+	  HOST slot_map<T>::slot::slot()
+	  : generation(0), is_occupied(false)
+	  {}
+
+	template <class T>
+	  HOST slot_map<T>::slot::slot(slot && s)
+	  : generation(s.generation), is_occupied(false)
+	  {
+		if(s.occupied())
+		{
+		  construct(std::move(s.value()));
+		  s.destroy();
+		}
+	  }
+
+	template <class T>
+	  HOST slot_map<T>::slot::~slot()
+	  {
+		if(is_occupied)
+		  reinterpret_cast<T*>(&storage)->~T();
+	  }
+
+	template <class T>
+	  HOST void slot_map<T>::slot::construct(T && value)
+	  {
+		new (&storage) T(std::move(value));
+		is_occupied = true;
+	  }
+
+	template <class T>
+	  HOST void slot_map<T>::slot::destroy()
+	  {
+		reinterpret_cast<T*>(&storage)->~T();
+		is_occupied = false;
+		// invalidates every handle to this slot
+		++generation;
+	  }
+
+	template <class T>
+	  HOST T & slot_map<T>::slot::value()
+	  { return *reinterpret_cast<T*>(&storage); }
+
+	template <class T>
+	  HOST bool slot_map<T>::slot::occupied()const
+	  { return is_occupied; }
+
+	template <class T>
+	  HOST std::uint32_t slot_map<T>::slot::get_generation()const
+	  { return generation; }
+
+	template <class T>
+	  HOST slot_map<T>::~slot_map()
+	  { clear(); }
+
+	template <class T>
+	  HOST slot_handle slot_map<T>::insert(T && value)
+	  {
+		std::uint32_t index{0};
+		if(free_slots.size() > 0)
+		{
+		  index = free_slots.back();
+		  free_slots.pop_back();
+		}
+		else
+		{
+		  index = slots.size();
+		  slots.emplace_back();
+		}
+		slots[index].construct(std::move(value));
+		return slot_handle(index, slots[index].get_generation());
+	  }
+
+	template <class T>
+	  HOST bool slot_map<T>::contains(const slot_handle & handle)const
+	  {
+		return handle.get_index() < slots.size() &&
+		       slots[handle.get_index()].occupied() &&
+			   slots[handle.get_index()].get_generation() == handle.get_generation();
+	  }
+
+	template <class T>
+	  HOST T & slot_map<T>::at(const slot_handle & handle)
+	  {
+		if(!contains(handle))
+		  throw std::out_of_range("slot_map: stale handle to slot " + std::to_string(handle.get_index()));
+		return slots[handle.get_index()].value();
+	  }
+
+	template <class T>
+	  HOST void slot_map<T>::erase(const slot_handle & handle)
+	  {
+		if(!contains(handle))
+		  throw std::out_of_range("slot_map: stale handle to slot " + std::to_string(handle.get_index()));
+		slots[handle.get_index()].destroy();
+		free_slots.push_back(handle.get_index());
+	  }
+
+	template <class T>
+	  HOST void slot_map<T>::clear()
+	  {
+		for(std::uint32_t i = 0; i < slots.size(); ++i)
+		  if(slots[i].occupied())
+		  {
+			slots[i].destroy();
+			free_slots.push_back(i);
+		  }
+	  }
+
+	template <class T>
+	  HOST std::uint32_t slot_map<T>::size()const
+	  { return slots.size() - free_slots.size(); }
+
+	template <class T>
+	  HOST std::uint32_t slot_map<T>::capacity()const
+	  { return slots.size(); }
+
+	template <class T>
+	  template <class UnaryFunction>
+	  HOST void slot_map<T>::for_each(UnaryFunction f)
+	  {
+		for(std::uint32_t i = 0; i < slots.size(); ++i)
+		  if(slots[i].occupied())
+			f(slots[i].value());
+	  }
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -0,0 +1,139 @@
+#ifndef ZINHART_SORT_TCC
+#define ZINHART_SORT_TCC
+#include <algorithm>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  template <class RandomIt1, class RandomIt2, class Compare>
+		HOST std::size_t merge_path(const std::size_t k, RandomIt1 a, const std::size_t a_size, RandomIt2 b, const std::size_t b_size, Compare comp)
+		{
+		  std::size_t low{k > b_size ? k - b_size : 0};
+		  std::size_t high{std::min(k, a_size)};
+		  while(low < high)
+		  {
+			const std::size_t i{low + (high - low) / 2};
+			const std::size_t j{k - i};
+			// a[i] is not greater than b[j - 1] so a stable merge takes it first, more of a belongs to the first k
+			if(j > 0 && i < a_size && !comp( *(b + (j - 1)), *(a + i) ))
+			  low = i + 1;
+			else
+			  high = i;
+		  }
+		  return low;
+		}
+
+	  template <class SourceIt, class DestinationIt, class Compare>
+		HOST void merge_round(SourceIt source, DestinationIt destination, const std::vector<std::size_t> & bounds, Compare comp, thread_pool::scheduler & scheduler)
+		{
+		  const std::size_t n_elements{bounds.back()};
+		  const std::size_t n_chunks{auto_chunks(n_elements, sizeof(typename std::iterator_traits<SourceIt>::value_type), scheduler)};
+		  // the run pair an output position falls in, a position on the boundary belongs to the pair that starts there
+		  auto pair_of = [&bounds](std::size_t position)
+		  {
+			std::size_t run{0};
+			while(run + 2 < bounds.size() && bounds[run + 2] <= position)
+			  run += 2;
+			return run;
+		  };
+		  // the merge path of each chunk's first output, found before any chunk starts moving elements out of source
+		  std::vector<std::size_t> splits(n_chunks);
+		  for(std::size_t chunk_id = 0, start = 0, stop = 0; chunk_id < n_chunks; ++chunk_id)
+		  {
+			zinhart::multi_core::map(chunk_id, n_chunks, n_elements, start, stop);
+			const std::size_t run{pair_of(start)};
+			const std::size_t a_begin{bounds[run]}, b_begin{bounds[run + 1]};
+			const std::size_t b_end{run + 2 < bounds.size() ? bounds[run + 2] : b_begin};
+			splits[chunk_id] = merge_path(start - a_begin, source + a_begin, b_begin - a_begin, source + b_begin, b_end - b_begin, comp);
+		  }
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  // every pair of runs whose output overlaps [start, stop)
+			  for(std::size_t run = pair_of(start); run + 1 < bounds.size() && bounds[run] < stop; run += 2)
+			  {
+				const std::size_t a_begin{bounds[run]};
+				const std::size_t b_begin{bounds[run + 1]};
+				const std::size_t b_end{run + 2 < bounds.size() ? bounds[run + 2] : b_begin};
+				const std::size_t a_size{b_begin - a_begin};
+				const std::size_t k_begin{std::max(start, a_begin) - a_begin};
+				const std::size_t k_end{std::min(stop, b_end) - a_begin};
+				const std::size_t i_begin{start > a_begin ? splits[chunk_id] : 0};
+				// a chunk that ends inside this pair ends where the next chunk starts
+				const std::size_t i_end{stop < b_end ? splits[chunk_id + 1] : a_size};
+				std::merge(std::make_move_iterator(source + (a_begin + i_begin)), std::make_move_iterator(source + (a_begin + i_end)),
+				           std::make_move_iterator(source + (b_begin + k_begin - i_begin)), std::make_move_iterator(source + (b_begin + k_end - i_end)),
+						   destination + (a_begin + k_begin), comp);
+			  }
+			}, scheduler
+		  );
+		}
+
+	  template <class RandomIt, class Compare>
+		HOST void merge_sort(RandomIt first, RandomIt last, Compare comp, const bool stable, thread_pool::scheduler & scheduler)
+		{
+		  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+		  const std::size_t n_elements = std::distance(first, last);
+		  const std::size_t n_chunks{auto_chunks(n_elements, sizeof(value_type), scheduler)};
+		  if(n_chunks <= 1)
+		  {
+			if(stable)
+			  std::stable_sort(first, last, comp);
+			else
+			  std::sort(first, last, comp);
+			return;
+		  }
+		  std::vector<std::size_t> bounds(n_chunks + 1);
+		  fork_join(n_elements, n_chunks, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			{
+			  bounds[chunk_id] = start;
+			  if(chunk_id + 1 == n_chunks)
+				bounds[n_chunks] = stop;
+			  if(stable)
+				std::stable_sort(first + start, first + stop, comp);
+			  else
+				std::sort(first + start, first + stop, comp);
+			}, scheduler
+		  );
+		  std::vector<value_type> buffer(n_elements);
+		  bool in_buffer{false};
+		  while(bounds.size() > 2)
+		  {
+			if(in_buffer)
+			  merge_round(buffer.begin(), first, bounds, comp, scheduler);
+			else
+			  merge_round(first, buffer.begin(), bounds, comp, scheduler);
+			in_buffer = !in_buffer;
+			// every other bound disappears, the end always stays
+			std::vector<std::size_t> merged_bounds;
+			for(std::size_t run = 0; run + 1 < bounds.size(); run += 2)
+			  merged_bounds.push_back(bounds[run]);
+			merged_bounds.push_back(bounds.back());
+			bounds.swap(merged_bounds);
+		  }
+		  if(in_buffer)
+			fork_join(n_elements, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+			  { std::move(buffer.begin() + start, buffer.begin() + stop, first + start); }, scheduler
+			);
+		}
+
+	  template <class RandomIt>
+		HOST void sort(RandomIt first, RandomIt last, thread_pool::scheduler & scheduler)
+		{ merge_sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), false, scheduler); }
+
+	  template <class RandomIt, class Compare>
+		HOST void sort(RandomIt first, RandomIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{ merge_sort(first, last, comp, false, scheduler); }
+
+	  template <class RandomIt>
+		HOST void stable_sort(RandomIt first, RandomIt last, thread_pool::scheduler & scheduler)
+		{ merge_sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), true, scheduler); }
+
+	  template <class RandomIt, class Compare>
+		HOST void stable_sort(RandomIt first, RandomIt last, Compare comp, thread_pool::scheduler & scheduler)
+		{ merge_sort(first, last, comp, true, scheduler); }
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
@@ -6,27 +6,45 @@ namespace zinhart
   {
 	template <class T>
   	  HOST task_manager<T>::task_manager(std::uint32_t n_threads)
-	  { thread_pool.resize(n_threads); }
+	  : next_push_id(0), unclaimed_completions(0), private_thread_pool(new thread_pool::scheduler(n_threads)), thread_pool(*private_thread_pool)
+	  { }
+
+	template <class T>
+  	  HOST task_manager<T>::task_manager(thread_pool::scheduler & scheduler)
+	  : next_push_id(0), unclaimed_completions(0), thread_pool(scheduler)
+	  { }
 	
 	template <class T>
 	  HOST task_manager<T>::~task_manager()
 	  {
-		for(std::uint32_t task_id = 0; task_id < pending_tasks.size(); ++task_id)
-		  if(valid(task_id))
-			get(task_id);
+		// the scheduler may outlive this manager, so wait on every task including those whose futures push_at discarded
+		drain_completions();
+		pending_tasks.for_each([](tracked_future & pending_task)
+		  {
+			if(pending_task.future.valid())
+			  pending_task.future.get();
+		  }
+		);
 	  } 
 
 	template <class T>
-	  HOST T task_manager<T>::get(std::uint64_t index)
-	  { return pending_tasks.at(index).get(); }
+	  HOST T task_manager<T>::get(const slot_handle & handle)
+	  { 
+		thread_pool::tasks::task_future<T> pending_task{std::move(pending_tasks.at(handle).future)};
+		// free the slot before waiting so that it is recycled even if the task threw
+		pending_tasks.erase(handle);
+		return pending_task.get(); 
+	  }
 
 	template <class T>
-	  HOST bool task_manager<T>::valid(std::uint64_t index)
-	  { return pending_tasks.at(index).valid(); }
+	  HOST bool task_manager<T>::valid(const slot_handle & handle)const
+	  { return pending_tasks.contains(handle); }
 
 	template <class T>
 	  HOST void task_manager<T>::resize(std::uint64_t n_threads)
 	  { 
+		if(!private_thread_pool)
+		  throw std::logic_error("task_manager: cannot resize a scheduler it shares, resize it through its owner");
 		thread_pool.resize(n_threads);
 	  }
 	template <class T>
@@ -35,20 +53,34 @@ namespace zinhart
 		return thread_pool.size();
 	  }
 
+	template <class T>
+	  HOST std::uint64_t task_manager<T>::pending()const
+	  { return pending_tasks.size(); }
+
 	template <class T>
 	  template<class Callable, class ... Args>
 	  HOST T task_manager<T>::push_wait(std::uint64_t priority, Callable && c, Args&&...args)
 	  {
-		thread_pool::tasks::task_future<T> pending_task{thread_pool.add_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...)};
+		thread_pool::tasks::task_future<T> pending_task{thread_pool.add_priority_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...)};
 		return pending_task.get();
 	  }
   
 	template <class T>
 	  template<class Callable, class ... Args>
-	  HOST void task_manager<T>::push(std::uint64_t priority, Callable && c, Args&&...args)
+	  HOST slot_handle task_manager<T>::push(std::uint64_t priority, Callable && c, Args&&...args)
 	  {
-		thread_pool::tasks::task_future<T> pending_task{thread_pool.add_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...)};
-		pending_tasks.push_back(std::move(pending_task));
+		// reserve a slot first since the task needs its handle to report completion
+		const slot_handle handle{pending_tasks.insert(tracked_future{thread_pool::tasks::task_future<T>{std::future<T>{}}, 0})};
+		try
+		{
+		  pending_tasks.at(handle) = add_task(handle, priority, std::forward<Callable>(c), std::forward<Args>(args)...);
+		}
+		catch(...)
+		{
+		  pending_tasks.erase(handle);
+		  throw;
+		}
+		return handle;
 	  }
 
 	template <class T>
@@ -58,14 +90,89 @@ namespace zinhart
 
 	template <class T>
 	  template<class Callable, class ... Args>
-	  HOST void task_manager<T>::push_at(std::uint64_t at, std::uint64_t priority, Callable && c, Args&&...args)
+	  HOST void task_manager<T>::push_at(const slot_handle & at, std::uint64_t priority, Callable && c, Args&&...args)
 	  {
-		thread_pool::tasks::task_future<T> pending_task{thread_pool.add_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...)};
-		pending_tasks.at(at) = std::move(pending_task);
+		// check the handle before the task is queued
+		pending_tasks.at(at);
+		pending_tasks.at(at) = add_task(at, priority, std::forward<Callable>(c), std::forward<Args>(args)...);
 	  }
 
+	template <class T>
+	  HOST bool task_manager<T>::next_completed(slot_handle & handle)
+	  {
+		completion done;
+		while(unclaimed_completions > 0)
+		{
+		  completed_tasks.pop_on_available(done);
+		  --unclaimed_completions;
+		  // the result may have already been taken by get, in which case the handle is stale,
+		  // or push_at may have replaced the task, in which case its replacement reports the slot
+		  if(valid(done.handle) && pending_tasks.at(done.handle).push_id == done.push_id)
+		  {
+			handle = done.handle;
+			return true;
+		  }
+		}
+		return false;
+	  }
 
-	
+	template <class T>
+	  template <class Result>
+	  HOST bool task_manager<T>::next_completed(slot_handle & handle, Result & result)
+	  {
+		if(!next_completed(handle))
+		  return false;
+		result = get(handle);
+		return true;
+	  }
+
+	template <class T>
+	  HOST void task_manager<T>::drain_completions()
+	  {
+		completion done;
+		while(unclaimed_completions > 0)
+		{
+		  completed_tasks.pop_on_available(done);
+		  --unclaimed_completions;
+		}
+	  }
+
+	template <class T>
+	  template<class Callable, class ... Args>
+	  HOST typename task_manager<T>::tracked_future task_manager<T>::add_task(const slot_handle & handle, std::uint64_t priority, Callable && c, Args&&...args)
+	  {
+		auto bound_task = std::bind(std::forward<Callable>(c), std::forward<Args>(args)...);
+		const completion done{handle, next_push_id};
+		completion_notifier<decltype(bound_task)> notifier(std::move(bound_task), done, completed_tasks);
+		tracked_future pending_task{thread_pool.add_priority_task(priority, std::move(notifier)), done.push_id};
+		++next_push_id;
+		++unclaimed_completions;
+		return pending_task;
+	  }
+
+	template <class T>
+	  HOST T task_manager<heterogeneous>::get(const task_handle<T> & handle)
+	  {
+		thread_pool::tasks::any_task_future & any_future = pending_tasks.at(handle);
+		if(!any_future.holds<T>())
+		  throw std::invalid_argument("task_manager: handle to slot " + std::to_string(handle.get_index()) + " does not match the result type of its task");
+		thread_pool::tasks::task_future<T> pending_task{std::move(any_future.get_future<T>())};
+		// free the slot before waiting so that it is recycled even if the task threw
+		pending_tasks.erase(handle);
+		return pending_task.get(); 
+	  }
+
+	template<class Callable, class ... Args>
+	  HOST auto task_manager<heterogeneous>::push_wait(std::uint64_t priority, Callable && c, Args&&...args) -> typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type
+	  { return thread_pool.add_priority_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...).get(); }
+
+	template<class Callable, class ... Args>
+	  HOST auto task_manager<heterogeneous>::push(std::uint64_t priority, Callable && c, Args&&...args) -> task_handle<typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type>
+	  {
+		using result_type = typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type;
+		thread_pool::tasks::task_future<result_type> pending_task{thread_pool.add_priority_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...)};
+		return task_handle<result_type>(pending_tasks.insert(thread_pool::tasks::any_task_future(std::move(pending_task))));
+	  }
   }// END NAMESPACE MULTI_CORE
 }// END NAMESPACE ZINHART
 #endif
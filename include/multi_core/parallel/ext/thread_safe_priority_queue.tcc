@@ -4,6 +4,7 @@ namespace zinhart
   {
 	template<class T, class Container, class Compare>
 	  HOST thread_safe_priority_queue<T, Container, Compare>::thread_safe_priority_queue()
+	  : count(0)
   	  { wakeup(); }
 	template<class T, class Container, class Compare>
 	  HOST void thread_safe_priority_queue<T, Container, Compare>::wakeup()
@@ -28,6 +29,7 @@ namespace zinhart
 		std::lock_guard<std::mutex> local_lock(lock);
 		// add item to the queue
 		priority_queue.push(item);
+		count.store(priority_queue.size(), std::memory_order_relaxed);
 		// notify a thread that an item is ready to be removed from the queue
 		cv.notify_one();
 	  }
@@ -37,9 +39,21 @@ namespace zinhart
 		std::lock_guard<std::mutex> local_lock(lock);
 		// add item to the queue
 		priority_queue.push(std::move(item));
+		count.store(priority_queue.size(), std::memory_order_relaxed);
 		// notify a thread that an item is ready to be removed from the queue
 		cv.notify_one();
 	  }
+	template<class T, class Container, class Compare>
+	  HOST void thread_safe_priority_queue<T, Container, Compare>::push_n(const T & item, std::uint32_t n_copies)
+	  {
+		std::lock_guard<std::mutex> local_lock(lock);
+		for(std::uint32_t i = 0; i < n_copies; ++i)
+		  priority_queue.push(item);
+		count.store(priority_queue.size(), std::memory_order_relaxed);
+		// notify as many threads as there are new items
+		for(std::uint32_t i = 0; i < n_copies; ++i)
+		  cv.notify_one();
+	  }
 	template<class T, class Container, class Compare>
 	  HOST bool thread_safe_priority_queue<T, Container, Compare>::pop(T & item)
 	  {
@@ -50,6 +64,7 @@ namespace zinhart
 		  item = std::move(priority_queue.top());
 		  // update queue
 		  priority_queue.pop();
+		  count.store(priority_queue.size(), std::memory_order_relaxed);
 		  // successfull write
 		  return true;
 		}
@@ -73,18 +88,25 @@ namespace zinhart
 		item = std::move(priority_queue.top());
 		// update queue
 		priority_queue.pop();
+		count.store(priority_queue.size(), std::memory_order_relaxed);
 		// successfull write
 		return true;
 	  }
 
 	template<class T, class Container, class Compare>
-	  HOST std::uint32_t thread_safe_priority_queue<T, Container, Compare>::size()
+	  HOST std::uint32_t thread_safe_priority_queue<T, Container, Compare>::size() const
+	  { return count.load(std::memory_order_relaxed); }
+	template<class T, class Container, class Compare>
+	  HOST bool thread_safe_priority_queue<T, Container, Compare>::empty() const
+	  { return size() == 0; }
+	template<class T, class Container, class Compare>
+	  HOST std::uint32_t thread_safe_priority_queue<T, Container, Compare>::size_exact()
 	  {
 		std::lock_guard<std::mutex> local_lock(lock);
 		return priority_queue.size();
 	  }
 	template<class T, class Container, class Compare>
-	  HOST bool thread_safe_priority_queue<T, Container, Compare>::empty()
+	  HOST bool thread_safe_priority_queue<T, Container, Compare>::empty_exact()
 	  {
 		std::lock_guard<std::mutex> local_lock(lock);
 		return priority_queue.empty();
@@ -95,6 +117,7 @@ namespace zinhart
 		std::lock_guard<std::mutex> local_lock(lock);
 		while(priority_queue.size() > 0)
 		  priority_queue.pop();
+		count.store(0, std::memory_order_relaxed);
 		cv.notify_all();
 	  }
   }// END NAMESPACE MULTI_CORE
@@ -4,6 +4,7 @@ namespace zinhart
   {
 	template<class T, class Container>
 	  HOST thread_safe_queue<T, Container>::thread_safe_queue()
+	  : count(0)
   	  { wakeup(); }
 	template<class T, class Container>
 	  HOST void thread_safe_queue<T, Container>::wakeup()
@@ -28,6 +29,7 @@ namespace zinhart
 		std::lock_guard<std::mutex> local_lock(lock);
 		// add item to the queue
 		queue.push(item);
+		count.store(queue.size(), std::memory_order_relaxed);
 		// notify a thread that an item is ready to be removed from the queue
 		cv.notify_one();
 	  }
@@ -37,9 +39,21 @@ namespace zinhart
 		std::lock_guard<std::mutex> local_lock(lock);
 		// add item to the queue
 		queue.push(std::move(item));
+		count.store(queue.size(), std::memory_order_relaxed);
 		// notify a thread that an item is ready to be removed from the queue
 		cv.notify_one();
 	  }
+	template<class T, class Container>
+	  HOST void thread_safe_queue<T, Container>::push_n(const T & item, std::uint32_t n_copies)
+	  {
+		std::lock_guard<std::mutex> local_lock(lock);
+		for(std::uint32_t i = 0; i < n_copies; ++i)
+		  queue.push(item);
+		count.store(queue.size(), std::memory_order_relaxed);
+		// notify as many threads as there are new items
+		for(std::uint32_t i = 0; i < n_copies; ++i)
+		  cv.notify_one();
+	  }
 	template<class T, class Container>
 	  HOST bool thread_safe_queue<T, Container>::pop(T & item)
 	  {
@@ -50,6 +64,7 @@ namespace zinhart
 		  item = std::move(queue.front());
 		  // update queue
 		  queue.pop();
+		  count.store(queue.size(), std::memory_order_relaxed);
 		  // successfull write
 		  return true;
 		}
@@ -73,18 +88,25 @@ namespace zinhart
 		item = std::move(queue.front());
 		// update queue
 		queue.pop();
+		count.store(queue.size(), std::memory_order_relaxed);
 		// successfull write
 		return true;
 	  }
 
 	template<class T, class Container>
-	  HOST std::uint32_t thread_safe_queue<T, Container>::size()
+	  HOST std::uint32_t thread_safe_queue<T, Container>::size() const
+	  { return count.load(std::memory_order_relaxed); }
+	template<class T, class Container>
+	  HOST bool thread_safe_queue<T, Container>::empty() const
+	  { return size() == 0; }
+	template<class T, class Container>
+	  HOST std::uint32_t thread_safe_queue<T, Container>::size_exact()
 	  {
 		std::lock_guard<std::mutex> local_lock(lock);
 		return queue.size();
 	  }
 	template<class T, class Container>
-	  HOST bool thread_safe_queue<T, Container>::empty()
+	  HOST bool thread_safe_queue<T, Container>::empty_exact()
 	  {
 		std::lock_guard<std::mutex> local_lock(lock);
 		return queue.empty();
@@ -95,6 +117,7 @@ namespace zinhart
 		std::lock_guard<std::mutex> local_lock(lock);
 		while(queue.size() > 0)
 		  queue.pop();
+		count.store(0, std::memory_order_relaxed);
 		cv.notify_all();
 	  }
   }// END NAMESPACE MULTI_CORE
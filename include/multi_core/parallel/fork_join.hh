@@ -0,0 +1,90 @@
+#ifndef ZINHART_FORK_JOIN_HH
+#define ZINHART_FORK_JOIN_HH
+#include <multi_core/macros.hh>
+#include <multi_core/serial/serial.hh> // for map 
+#include <multi_core/parallel/thread_pool.hh>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  // the number of chunks fork_join splits n_elements into by default, one for each worker and one for the calling thread
+	  HOST std::size_t default_chunks(const std::size_t n_elements, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // below this many bytes of input handing a chunk to a worker costs more than running it
+	  constexpr std::size_t min_bytes_per_task{1 << 15};
+
+	  // one chunk per participating thread but never so many that a chunk covers less than min_bytes_per_task,
+	  // so small inputs get a single chunk and run inline on the calling thread
+	  HOST std::size_t auto_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  enum class schedule_kind : std::uint8_t {static_chunks = 0, dynamic_chunks, guided_chunks, auto_chunks};
+
+	  /*
+	   * How a range is cut into chunks, whatever the kind chunks are claimed one at a time from a shared counter so a thread that finishes early takes the next one.
+	   * static_chunks:  one equal chunk per participating thread, the cheapest when every element costs the same
+	   * dynamic_chunks: chunks of grain elements, balances uneven per element costs at the price of one claim per chunk
+	   * guided_chunks:  chunks start at a share of what remains and shrink to grain, few claims early and fine balancing at the end
+	   * auto_chunks:    static chunks of at least grain elements, see auto_schedule
+	   * */
+	  class schedule
+	  {
+		public:
+		  HOST schedule(const schedule_kind kind = schedule_kind::static_chunks, const std::size_t grain = 1);
+		  HOST schedule_kind get_kind()const;
+		  HOST std::size_t get_grain()const;
+		private:
+		  schedule_kind kind;
+		  std::size_t grain;
+	  };
+
+	  // the schedule the algorithms use by default, static chunks of at least min_bytes_per_task
+	  HOST schedule auto_schedule(const std::size_t bytes_per_element);
+
+	  // the chunks a schedule cuts [0, n_elements) into for n_participants threads, chunk ids run from 0 to size() in element order
+	  class chunk_plan
+	  {
+		public:
+		  HOST chunk_plan(const schedule & policy, const std::size_t n_elements, const std::size_t n_participants);
+		  HOST std::size_t size()const;
+		  HOST std::size_t get_n_elements()const;
+		  HOST void range(const std::size_t chunk_id, std::size_t & start, std::size_t & stop)const;
+		private:
+		  schedule_kind kind;
+		  std::size_t n_elements;
+		  std::size_t grain;
+		  std::size_t n_chunks;
+		  // chunk boundaries, only guided chunks need them
+		  std::vector<std::size_t> bounds;
+	  };
+
+	  // Calls body(chunk_id, start, stop) on each of the n_chunks static chunks that map assigns to [0, n_elements) and returns once all of them have run.
+	  // The calling thread claims chunks alongside the scheduler's workers, so the whole call costs one batch submission,
+	  // never waits on a task that has not started and is safe to nest inside another task.
+	  // The first exception thrown by body is rethrown once every chunk has finished.
+	  template <class Body>
+		HOST void fork_join(const std::size_t n_elements, const std::size_t n_chunks, Body body, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // same as above with default_chunks(n_elements, scheduler) chunks
+	  template <class Body>
+		HOST void fork_join(const std::size_t n_elements, Body body, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // same as above with the chunks of policy for the scheduler's workers plus the calling thread
+	  template <class Body>
+		HOST void fork_join(const std::size_t n_elements, const schedule & policy, Body body, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // runs the chunks of plan, use this when several passes must see the same chunks
+	  template <class Body>
+		HOST void fork_join(const chunk_plan & plan, Body body, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/fork_join.tcc>
+#endif
@@ -0,0 +1,42 @@
+#ifndef ZINHART_HISTOGRAM_HH
+#define ZINHART_HISTOGRAM_HH
+#include <multi_core/parallel/fork_join.hh>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Histograms. While a private copy of the bins fits in private_histogram_bytes every chunk counts into its own copy, the copies start
+	 * on separate cache lines so no two threads write the same line, and the copies are summed bin by bin in a second parallel pass.
+	 * Larger bin counts would spend more time zeroing and merging copies than counting, so every chunk increments one shared set of
+	 * atomic bins instead. Either way counts[0, n_bins) is overwritten with the totals and the number of elements that fell in a bin is returned.
+	 * */
+	namespace parallel
+	{
+	  // about an l2 cache
+	  constexpr std::size_t private_histogram_bytes{1 << 18};
+
+	  // the engine behind the histograms below, bin(i) returns the bin of element i or n_bins to skip it
+	  template <class BinFunction>
+		HOST std::size_t histogram_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, BinFunction bin, std::size_t * counts, const std::size_t n_bins,
+		                                  thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // counts[v] is the number of elements equal to v, integer elements outside [0, n_bins) are skipped
+	  template <class InputIt>
+		HOST std::size_t bincount(InputIt first, InputIt last, std::size_t * counts, const std::size_t n_bins, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // n_bins equal bins over [lower, upper], the last bin includes upper, elements outside the range and nans are skipped.
+	  // Bins are computed in double or a wider common type of the elements and bounds, throws std::invalid_argument unless lower < upper
+	  template <class InputIt, class T>
+		HOST std::size_t histogram(InputIt first, InputIt last, const T lower, const T upper, std::size_t * counts, const std::size_t n_bins,
+		                           thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/histogram.tcc>
+#endif
@@ -0,0 +1,90 @@
+#ifndef ZINHART_RADIX_SORT_HH
+#define ZINHART_RADIX_SORT_HH
+#include <multi_core/parallel/fork_join.hh>
+#include <type_traits>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Parallel LSD radix sort over 8 bit digits. Each pass counts digits into a histogram per chunk, scans the histograms digit major
+	 * into a write offset for every (chunk, digit) and scatters each chunk in order, so every pass and the sort as a whole are stable.
+	 * Passes where every key has the same digit are skipped. Keys ping-pong between the input and a buffer of the same size,
+	 * which is allocated for the duration of the call unless the caller passes one, the sorted output always ends up in keys.
+	 * */
+	namespace parallel
+	{
+	  template <std::size_t Bytes>
+		class radix_unsigned;
+	  template <>
+		class radix_unsigned<1>
+		{ public: using type = std::uint8_t; };
+	  template <>
+		class radix_unsigned<2>
+		{ public: using type = std::uint16_t; };
+	  template <>
+		class radix_unsigned<4>
+		{ public: using type = std::uint32_t; };
+	  template <>
+		class radix_unsigned<8>
+		{ public: using type = std::uint64_t; };
+
+	  // maps a key to unsigned bits that order the same way as the key
+	  template <class Key, class Enable = void>
+		class radix_traits;
+
+	  template <class Key>
+		class radix_traits<Key, typename std::enable_if<std::is_integral<Key>::value && std::is_unsigned<Key>::value>::type>
+		{
+		  public:
+			using bits_type = typename radix_unsigned<sizeof(Key)>::type;
+			HOST static bits_type encode(const Key key)
+			{ return key; }
+		};
+
+	  // two's complement with the sign bit flipped orders negatives first
+	  template <class Key>
+		class radix_traits<Key, typename std::enable_if<std::is_integral<Key>::value && std::is_signed<Key>::value>::type>
+		{
+		  public:
+			using bits_type = typename radix_unsigned<sizeof(Key)>::type;
+			HOST static bits_type encode(const Key key)
+			{ return static_cast<bits_type>(static_cast<bits_type>(key) ^ (bits_type(1) << (8 * sizeof(Key) - 1))); }
+		};
+
+	  // IEEE floats, negatives have every bit flipped and positives only the sign bit, -0.0 sorts before 0.0 and NaNs go to the ends
+	  template <class Key>
+		class radix_traits<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type>
+		{
+		  public:
+			using bits_type = typename radix_unsigned<sizeof(Key)>::type;
+			HOST static bits_type encode(const Key key);
+		};
+
+	  template <class Key>
+		HOST void radix_sort(Key * keys, const std::size_t n_elements, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // key_buffer must hold n_elements keys
+	  template <class Key>
+		HOST void radix_sort(Key * keys, const std::size_t n_elements, Key * key_buffer, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // sorts keys and moves values[i] along with keys[i]
+	  template <class Key, class Value>
+		HOST void sort_by_key(Key * keys, Value * values, const std::size_t n_elements, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class Key, class Value>
+		HOST void sort_by_key(Key * keys, Value * values, const std::size_t n_elements, Key * key_buffer, Value * value_buffer, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // writes the permutation that stably sorts keys to indices, keys are left untouched
+	  template <class Key>
+		HOST void argsort(const Key * keys, const std::size_t n_elements, std::size_t * indices, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the engine behind the above, values may be null
+	  template <class Key, class Value>
+		HOST void radix_sort_pairs(Key * keys, Value * values, const std::size_t n_elements, Key * key_buffer, Value * value_buffer, thread_pool::scheduler & scheduler);
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/radix_sort.tcc>
+#endif
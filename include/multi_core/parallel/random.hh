@@ -0,0 +1,107 @@
+#ifndef ZINHART_RANDOM_HH
+#define ZINHART_RANDOM_HH
+#include <multi_core/parallel/fork_join.hh>
+#include <multi_core/parallel/simd.hh>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Counter based random numbers. A counter based generator is a keyed bijection on its counter, so value i of a sequence is computed
+	 * directly from (seed, stream, i) with no state carried between values. Threads filling disjoint ranges need no shared generator,
+	 * and the output for a given seed does not depend on how the range was split.
+	 * */
+	namespace random
+	{
+	  // philox4x32-10 (Salmon et al, Parallel Random Numbers: As Easy as 1, 2, 3), each 128 bit counter maps to a block of four 32 bit words.
+	  // Also a std uniform random bit generator that walks the blocks of its stream in order
+	  class philox4x32
+	  {
+		public:
+		  using result_type = std::uint32_t;
+		  // words in a block
+		  static constexpr std::size_t block_words{4};
+		  HOST explicit philox4x32(const std::uint64_t seed = 0, const std::uint64_t stream = 0);
+		  HOST void seed(const std::uint64_t seed, const std::uint64_t stream = 0);
+		  HOST std::uint64_t get_seed()const;
+		  HOST std::uint64_t get_stream()const;
+		  // writes blocks first_counter ... first_counter + n_blocks - 1 of this stream to bits, 4 words per block, independent of the position below
+		  HOST void blocks(const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks)const;
+		  // the next word of the stream
+		  HOST result_type operator()();
+		  // skips z words in constant time
+		  HOST void discard(const unsigned long long z);
+		  HOST static constexpr result_type min()
+		  { return std::numeric_limits<result_type>::min(); }
+		  HOST static constexpr result_type max()
+		  { return std::numeric_limits<result_type>::max(); }
+		  HOST bool operator == (const philox4x32 & engine)const;
+		  HOST bool operator != (const philox4x32 & engine)const;
+		private:
+		  std::uint64_t key;
+		  std::uint64_t stream;
+		  // words handed out by operator()
+		  std::uint64_t position;
+		  // the block held in buffer, max when empty
+		  std::uint64_t buffered_block;
+		  std::uint32_t buffer[block_words];
+	  };
+
+	  // how float and double uniform variates are cut from the words of a block
+	  template <class precision_type>
+		class variates;
+
+	  // Distributions turn whole blocks into values, values_per_block values per block so that value i only ever depends on block i / values_per_block.
+	  // float values use one 32 bit word per uniform variate and double values two
+
+	  // uniform reals in [a, b)
+	  template <class precision_type>
+		class uniform_real
+		{
+		  public:
+			using result_type = precision_type;
+			static constexpr std::size_t values_per_block{16 / sizeof(precision_type)};
+			HOST uniform_real(const precision_type a = 0, const precision_type b = 1);
+			HOST precision_type a()const;
+			HOST precision_type b()const;
+			// writes n_blocks * values_per_block values
+			HOST void operator()(const std::uint32_t * bits, precision_type * values, const std::size_t n_blocks)const;
+		  private:
+			static_assert(std::is_same<precision_type, float>::value || std::is_same<precision_type, double>::value, "precision_type must be float or double");
+			precision_type lower;
+			precision_type range;
+		};
+
+	  // normal reals by the box-muller transform, each pair of uniform variates gives a pair of values
+	  template <class precision_type>
+		class normal
+		{
+		  public:
+			using result_type = precision_type;
+			static constexpr std::size_t values_per_block{16 / sizeof(precision_type)};
+			HOST normal(const precision_type mean = 0, const precision_type stddev = 1);
+			HOST precision_type mean()const;
+			HOST precision_type stddev()const;
+			HOST void operator()(const std::uint32_t * bits, precision_type * values, const std::size_t n_blocks)const;
+		  private:
+			static_assert(std::is_same<precision_type, float>::value || std::is_same<precision_type, double>::value, "precision_type must be float or double");
+			precision_type mu;
+			precision_type sigma;
+		};
+	}// END NAMESPACE RANDOM
+
+	namespace parallel
+	{
+	  // *(first + i) is value i of distribution over engine's stream, identical for any scheduler size or chunking,
+	  // the engine's position is ignored. Unlike generate no generator is shared between threads
+	  template <class RandomIt, class Distribution>
+		HOST void generate_random(RandomIt first, RandomIt last, const Distribution & distribution, const random::philox4x32 & engine,
+		                          thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/random.tcc>
+#endif
@@ -0,0 +1,104 @@
+#ifndef ZINHART_REDUCE_HH
+#define ZINHART_REDUCE_HH
+#include <multi_core/parallel/fork_join.hh>
+#include <multi_core/parallel/simd.hh>
+#include <functional>
+#include <iterator>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Race free reductions. Each chunk reduces its range into a private partial, partials sit at least a cache line apart
+	 * and are combined by the calling thread with a pairwise tree once every chunk is done. Results are returned by value.
+	 * binary operations are assumed associative, the order in which partials are combined is fixed for a given number of chunks.
+	 * */
+	namespace parallel
+	{
+	  // a partial result followed by a cache line of padding, so consecutive partials in a vector never share a line
+	  template <class T>
+		class padded_partial
+		{
+		  public:
+			T value;
+		  private:
+			char padding[CACHE_LINE_SIZE];
+		};
+
+	  // sum + correction, where correction holds the low order bits that sum could not represent
+	  template <class precision_type>
+		class compensated
+		{
+		  public:
+			precision_type sum;
+			precision_type correction;
+		};
+
+	  // adds two compensated values, the rounding error of sum_1 + sum_2 is recovered exactly (Knuth's two-sum) and folded into the correction
+	  template <class precision_type>
+		HOST compensated<precision_type> compensated_add(const compensated<precision_type> & x, const compensated<precision_type> & y);
+
+	  // reduces partials[0, n) in place with a pairwise tree and returns partials[0]
+	  template <class T, class BinaryOperation>
+		HOST T tree_combine(std::vector<padded_partial<T>> & partials, BinaryOperation op);
+
+	  // the engine behind every reduction here, chunk(start, stop) returns the partial for a non empty range,
+	  // bytes_per_element is how much input each element reads and sets how many chunks are worth it
+	  template <class T, class ChunkReduction, class BinaryOperation>
+		HOST T reduce_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, ChunkReduction chunk, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class T>
+		HOST T reduce(InputIt first, InputIt last, T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class T, class BinaryOperation>
+		HOST T reduce(InputIt first, InputIt last, T init, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class T, class BinaryOperation, class UnaryOperation>
+		HOST T transform_reduce(InputIt first, InputIt last, T init, BinaryOperation reduce_op, UnaryOperation transform_op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class T, class BinaryOperation1, class BinaryOperation2>
+		HOST T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, BinaryOperation1 reduce_op, BinaryOperation2 transform_op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class T>
+		HOST T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class T, class BinaryOperation1, class BinaryOperation2>
+		HOST T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init, BinaryOperation1 op1, BinaryOperation2 op2, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // compensated sums, each chunk keeps its own compensation and the partials are combined with compensated_add so no correction is lost
+	  template <class precision_type>
+		HOST precision_type kahan_sum(const precision_type * data, const std::size_t data_size, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class precision_type>
+		HOST precision_type neumaier_sum(const precision_type * data, const std::size_t data_size, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // sums bp(vec_1[i], vec_2[i])
+	  template <class precision_type, class binary_predicate>
+		HOST precision_type kahan_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t data_size, binary_predicate bp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class precision_type, class binary_predicate>
+		HOST precision_type neumaier_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t data_size, binary_predicate bp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  /*
+	   * Reproducible sums. The data is cut into blocks of reproducible_block_size elements no matter how many workers there are,
+	   * each block is summed in order with neumaier's algorithm and the block sums are combined with a fixed pairwise tree,
+	   * so for a given input the result is bitwise identical for any scheduler size.
+	   * */
+	  constexpr std::size_t reproducible_block_size{4096};
+
+	  // element(i) returns the i'th summand
+	  template <class precision_type, class Element>
+		HOST precision_type reproducible_sum_blocks(Element element, const std::size_t data_size, thread_pool::scheduler & scheduler);
+
+	  template <class precision_type>
+		HOST precision_type reproducible_sum(const precision_type * data, const std::size_t data_size, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // sums bp(vec_1[i], vec_2[i])
+	  template <class precision_type, class binary_predicate>
+		HOST precision_type reproducible_sum(const precision_type * vec_1, const precision_type * vec_2, const std::size_t data_size, binary_predicate bp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/reduce.tcc>
+#endif
@@ -0,0 +1,51 @@
+#ifndef ZINHART_SCAN_HH
+#define ZINHART_SCAN_HH
+#include <multi_core/parallel/reduce.hh>
+#include <functional>
+#include <iterator>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Two pass (reduce then scan) prefix scans. The first pass reduces each chunk to a partial, the calling thread scans the partials into
+	 * a carry for each chunk and the second pass scans each chunk starting from its carry. Both passes split the range identically,
+	 * so the input is read twice and the output written once. binary operations must be associative, output_first may equal first.
+	 * */
+	namespace parallel
+	{
+	  // the engine behind the scans below, init is only used when has_init is true and is required by exclusive scans
+	  template <class T, class InputIt, class OutputIt, class BinaryOperation, class UnaryOperation>
+		HOST OutputIt scan_chunks(InputIt first, const std::size_t n_elements, OutputIt output_first, BinaryOperation op, UnaryOperation unary_op,
+		                          const bool exclusive, const bool has_init, const T & init, thread_pool::scheduler & scheduler);
+
+	  template <class InputIt, class OutputIt>
+		HOST OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt output_first, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class BinaryOperation>
+		HOST OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class BinaryOperation, class T>
+		HOST OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class T>
+		HOST OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt output_first, T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt output_first, T init, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class BinaryOperation, class UnaryOperation>
+		HOST OutputIt transform_inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, UnaryOperation unary_op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class OutputIt, class BinaryOperation, class UnaryOperation, class T>
+		HOST OutputIt transform_inclusive_scan(InputIt first, InputIt last, OutputIt output_first, BinaryOperation op, UnaryOperation unary_op, T init, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // cumulative sums that carry a compensation through each chunk and across chunks, output[i] is the compensated sum of data[0, i] rounded once
+	  template <class precision_type>
+		HOST precision_type * compensated_inclusive_scan(const precision_type * data, const std::size_t data_size, precision_type * output, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/scan.tcc>
+#endif
@@ -0,0 +1,79 @@
+#ifndef ZINHART_SEARCH_HH
+#define ZINHART_SEARCH_HH
+#include <multi_core/parallel/reduce.hh>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <utility>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Searches and selections. The searches claim dynamic chunks in element order and publish the position of a match in a shared atomic bound,
+	 * every chunk looks at the bound between blocks of search_block elements and stops once a match below its position is known,
+	 * so a match near the front ends the search after roughly a chunk per thread instead of a full scan.
+	 * The selections are reductions, each chunk keeps the position of its own extreme or count and the partials are combined in chunk order,
+	 * positions and ties match the std versions.
+	 * */
+	namespace parallel
+	{
+	  // elements a chunk tests between looks at the bound
+	  constexpr std::size_t search_block{1024};
+
+	  // the engine behind the searches, pred(i) tests element i. With lowest set returns the smallest matching i, otherwise any matching i,
+	  // n_elements when nothing matches
+	  template <class Predicate>
+		HOST std::size_t find_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, Predicate pred, const bool lowest,
+		                             thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST InputIt find_if(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST InputIt find_if_not(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class T>
+		HOST InputIt find(InputIt first, InputIt last, const T & value, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // these stop every chunk at the first match found anywhere
+	  template <class InputIt, class UnaryPredicate>
+		HOST bool any_of(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST bool all_of(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST bool none_of(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class UnaryPredicate>
+		HOST typename std::iterator_traits<InputIt>::difference_type count_if(InputIt first, InputIt last, UnaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt, class T>
+		HOST typename std::iterator_traits<InputIt>::difference_type count(InputIt first, InputIt last, const T & value, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the first smallest element, last when the range is empty
+	  template <class ForwardIt>
+		HOST ForwardIt min_element(ForwardIt first, ForwardIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class ForwardIt, class Compare>
+		HOST ForwardIt min_element(ForwardIt first, ForwardIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the first largest element
+	  template <class ForwardIt>
+		HOST ForwardIt max_element(ForwardIt first, ForwardIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class ForwardIt, class Compare>
+		HOST ForwardIt max_element(ForwardIt first, ForwardIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the first smallest and the last largest element, as std::minmax_element
+	  template <class ForwardIt>
+		HOST std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first, ForwardIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class ForwardIt, class Compare>
+		HOST std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first, ForwardIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/search.tcc>
+#endif
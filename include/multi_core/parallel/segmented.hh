@@ -0,0 +1,75 @@
+#ifndef ZINHART_SEGMENTED_HH
+#define ZINHART_SEGMENTED_HH
+#include <multi_core/parallel/reduce.hh>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Segmented reductions. reduce_by_key reduces each run of equal consecutive keys. A first pass counts the runs that start in each chunk,
+	 * which places every chunk's output, and a second pass writes the runs that start and end inside a chunk. A run that crosses into later chunks
+	 * leaves its pieces with those chunks and the calling thread joins them in chunk order, so op only needs to be associative.
+	 * row_reduce and col_reduce reduce the lines of an n_rows x n_cols matrix in either layout. Lines that are contiguous in memory are folded
+	 * one per thread, or with every thread on one line when there are too few of them. Strided lines are never walked with their stride,
+	 * a block of column_block_size accumulators sits in the l1 cache while the rows stream past it, one contiguous piece per row.
+	 * */
+	namespace parallel
+	{
+	  enum class matrix_layout : std::uint8_t {row_major = 0, column_major};
+
+	  // strided lines accumulated together, 4 KiB of doubles
+	  constexpr std::size_t column_block_size{512};
+
+	  // reduces each run of consecutive keys equal under pred to one key and one value, returns the ends of the two outputs
+	  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2>
+		HOST std::pair<OutputIt1, OutputIt2> reduce_by_key(InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first, OutputIt1 keys_output, OutputIt2 values_output,
+		                                                   thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2, class BinaryPredicate>
+		HOST std::pair<OutputIt1, OutputIt2> reduce_by_key(InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first, OutputIt1 keys_output, OutputIt2 values_output,
+		                                                   BinaryPredicate pred, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2, class BinaryPredicate, class BinaryOperation>
+		HOST std::pair<OutputIt1, OutputIt2> reduce_by_key(InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first, OutputIt1 keys_output, OutputIt2 values_output,
+		                                                   BinaryPredicate pred, BinaryOperation op, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the engines behind the matrix reductions. output[i] = line(matrix + i * line_length, line_length, init) for each of n_lines contiguous lines,
+	  // line folds its elements onto init in order with op
+	  template <class InputIt, class OutputIt, class T, class LineReduction, class BinaryOperation>
+		HOST OutputIt reduce_lines(InputIt matrix, const std::size_t n_lines, const std::size_t line_length, OutputIt output, const T & init, LineReduction line, BinaryOperation op,
+		                           thread_pool::scheduler & scheduler);
+
+	  // output[j] = init op matrix[j] op matrix[width + j] op ... op matrix[(depth - 1) * width + j] for each of width strided lines
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt reduce_strided(InputIt matrix, const std::size_t depth, const std::size_t width, OutputIt output, const T & init, BinaryOperation op,
+		                             thread_pool::scheduler & scheduler);
+
+	  // output[i] = init op a(i, 0) op a(i, 1) op ... op a(i, n_cols - 1) for each row, returns the end of the n_rows outputs
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt row_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init, BinaryOperation op,
+		                         thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // row sums, contiguous rows of float or double go to the simd kernels
+	  template <class InputIt, class OutputIt, class T>
+		HOST OutputIt row_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init,
+		                         thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // output[j] = init op a(0, j) op a(1, j) op ... op a(n_rows - 1, j) for each column, returns the end of the n_cols outputs
+	  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+		HOST OutputIt col_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init, BinaryOperation op,
+		                         thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // column sums
+	  template <class InputIt, class OutputIt, class T>
+		HOST OutputIt col_reduce(InputIt matrix, const matrix_layout layout, const std::size_t n_rows, const std::size_t n_cols, OutputIt output, const T & init,
+		                         thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/segmented.tcc>
+#endif
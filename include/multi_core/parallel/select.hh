@@ -0,0 +1,64 @@
+#ifndef ZINHART_SELECT_HH
+#define ZINHART_SELECT_HH
+#include <multi_core/parallel/reduce.hh>
+#include <multi_core/parallel/sort.hh>
+#include <array>
+#include <functional>
+#include <utility>
+#include <iterator>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Selection without a full sort. nth_element draws a sample, sorts it and takes two splitters a little either side of where the nth element
+	 * should fall, then every chunk counts and moves its elements into the three bands below, between and above the splitters through a buffer.
+	 * The band holding the nth element becomes the new range, usually a few percent of the old one, and once it is small a serial nth_element finishes.
+	 * partial_sort is nth_element followed by a parallel sort of the front.
+	 * top_k, and partial_sort when the front is short, keep a bounded heap of the best k elements per chunk and select the k best of the chunk candidates as above.
+	 * Elements must be default constructible and copyable.
+	 * */
+	namespace parallel
+	{
+	  // elements in the splitter sample and how far either side of the target rank the splitters sit
+	  constexpr std::size_t select_sample_size{4096};
+	  constexpr std::size_t select_sample_margin{96};
+
+	  // the engine behind nth_element
+	  template <class RandomIt, class Compare>
+		HOST void sample_select(RandomIt first, RandomIt nth, RandomIt last, Compare comp, thread_pool::scheduler & scheduler);
+
+	  // the k smallest elements under comp with their positions in order, equal elements in order of position, k must be at least 1 and at most n_elements.
+	  // Picked by per chunk heaps of (element, position) pairs when k is small, so the heaps never reach back into the input
+	  template <class RandomIt, class Compare>
+		HOST std::vector<std::pair<typename std::iterator_traits<RandomIt>::value_type, std::size_t>> smallest_k(RandomIt first, const std::size_t n_elements, const std::size_t k,
+		                                                                                                         Compare comp, thread_pool::scheduler & scheduler);
+
+	  // as std::nth_element, *nth is the element a sort would put there, nothing before it is greater and nothing after it is less
+	  template <class RandomIt>
+		HOST void nth_element(RandomIt first, RandomIt nth, RandomIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class RandomIt, class Compare>
+		HOST void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // as std::partial_sort, [first, middle) holds the smallest elements in order and the rest are in no particular order
+	  template <class RandomIt>
+		HOST void partial_sort(RandomIt first, RandomIt middle, RandomIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class RandomIt, class Compare>
+		HOST void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // writes the k largest elements under comp and their positions from the largest down, equal elements in order of position.
+	  // Returns the number written, the smaller of k and the size of the range
+	  template <class RandomIt, class ValueIt, class IndexIt>
+		HOST std::size_t top_k(RandomIt first, RandomIt last, const std::size_t k, ValueIt values, IndexIt indices, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class RandomIt, class ValueIt, class IndexIt, class Compare>
+		HOST std::size_t top_k(RandomIt first, RandomIt last, const std::size_t k, ValueIt values, IndexIt indices, Compare comp,
+		                       thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/select.tcc>
+#endif
@@ -0,0 +1,134 @@
+#ifndef ZINHART_SIMD_HH
+#define ZINHART_SIMD_HH
+#include <multi_core/macros.hh>
+#include <multi_core/serial/compensated.hh>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	// explicit simd kernels for float and double, each kernel is compiled once per instruction set and the widest one the cpu supports is picked at runtime
+	namespace simd
+	{
+	  // ordered from narrowest to widest, generic is whatever the build flags give
+	  enum class instruction_set : std::uint32_t {generic = 0, sse2, avx2, avx512};
+
+	  // the widest instruction set this cpu and os support
+	  HOST instruction_set detect_instruction_set();
+	  // the instruction set the kernels currently use
+	  HOST instruction_set get_instruction_set();
+	  // lowers the instruction set the kernels use, requests above what the cpu supports are clamped, returns the one in effect
+	  HOST instruction_set set_instruction_set(const instruction_set isa);
+	  HOST const char * to_string(const instruction_set isa);
+
+	  // y[i] = a * x[i] + y[i], avx2 and avx512 use fused multiply adds
+	  HOST void saxpy(const float a, const float * x, float * y, const std::size_t n_elements);
+	  HOST void saxpy(const double a, const double * x, double * y, const std::size_t n_elements);
+	  HOST void copy(const float * x, float * y, const std::size_t n_elements);
+	  HOST void copy(const double * x, double * y, const std::size_t n_elements);
+	  HOST void replace(float * x, const std::size_t n_elements, const float old_value, const float new_value);
+	  HOST void replace(double * x, const std::size_t n_elements, const double old_value, const double new_value);
+	  // the reductions keep one partial per lane, so the order of additions and the rounding depend on the instruction set
+	  HOST float accumulate(const float * x, const std::size_t n_elements);
+	  HOST double accumulate(const double * x, const std::size_t n_elements);
+	  HOST float inner_product(const float * x, const float * y, const std::size_t n_elements);
+	  HOST double inner_product(const double * x, const double * y, const std::size_t n_elements);
+	  // four registers of sums and compensations per instruction set, every lane is folded with a compensated add at the end
+	  HOST float kahan_sum(const float * x, const std::size_t n_elements);
+	  HOST double kahan_sum(const double * x, const std::size_t n_elements);
+	  HOST float neumaier_sum(const float * x, const std::size_t n_elements);
+	  HOST double neumaier_sum(const double * x, const std::size_t n_elements);
+	  // the same sums unrounded, sum + correction is the compensated total so a caller combining several sums loses none of the correction
+	  HOST float kahan_sum(const float * x, const std::size_t n_elements, float & correction);
+	  HOST double kahan_sum(const double * x, const std::size_t n_elements, double & correction);
+	  HOST float neumaier_sum(const float * x, const std::size_t n_elements, float & correction);
+	  HOST double neumaier_sum(const double * x, const std::size_t n_elements, double & correction);
+
+	  // philox4x32-10 blocks for the 128 bit counters (first_counter + i, stream) under key, block i is written to bits[4 i] ... bits[4 i + 3],
+	  // a block depends only on its key and counter so any split of the counters across threads gives the same bits
+	  HOST void philox4x32_blocks(const std::uint64_t key, const std::uint64_t stream, const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks);
+
+	  // y[i] = x[index[i]], avx2 and avx512 load whole registers with the hardware gathers, indices must be non negative
+	  HOST void gather(const float * x, const std::int32_t * index, float * y, const std::size_t n_elements);
+	  HOST void gather(const double * x, const std::int32_t * index, double * y, const std::size_t n_elements);
+	  HOST void gather(const float * x, const std::int64_t * index, float * y, const std::size_t n_elements);
+	  HOST void gather(const double * x, const std::int64_t * index, double * y, const std::size_t n_elements);
+
+	  // non-temporal stores write around the cache so copying or filling buffers far larger than the last level cache does not evict the working set,
+	  // the threshold defaults to the size of the last level cache and outputs at least that large stream
+	  HOST std::size_t get_streaming_threshold();
+	  HOST void set_streaming_threshold(const std::size_t bytes);
+	  HOST bool use_streaming_stores(const std::size_t output_bytes);
+	  // aligned non-temporal stores with a cached head and tail, each call ends with a store fence so the data is visible to whoever joins the calling thread
+	  HOST void stream_copy_bytes(const void * source, void * destination, const std::size_t bytes);
+	  // value_bytes must be a power of two no larger than 64 and destination aligned to it, otherwise the fill goes through the cache
+	  HOST void stream_fill_bytes(void * destination, const void * value, const std::size_t value_bytes, const std::size_t n_values);
+
+	  // true when It is a pointer to T and T is one of the types the kernels are compiled for
+	  template <class It, class T>
+		struct has_kernel : std::integral_constant<bool, std::is_pointer<It>::value &&
+		                                                 std::is_same<typename std::remove_cv<typename std::remove_pointer<It>::type>::type, T>::value &&
+		                                                 (std::is_same<T, float>::value || std::is_same<T, double>::value)>
+		{};
+
+	  // true when It is a pointer to a trivially copyable T, the only outputs that can be streamed
+	  template <class It, class T>
+		struct can_stream : std::integral_constant<bool, std::is_pointer<It>::value &&
+		                                                 std::is_same<typename std::remove_cv<typename std::remove_pointer<It>::type>::type, T>::value &&
+		                                                 std::is_trivial<T>::value>
+		{};
+
+	  // true when It is a pointer to the 32 bit signed or 64 bit indices the gather kernels take
+	  template <class It, bool = std::is_pointer<It>::value && std::is_integral<typename std::remove_pointer<It>::type>::value>
+		struct has_index_kernel : std::false_type
+		{};
+	  template <class It>
+		struct has_index_kernel<It, true> : std::integral_constant<bool, std::is_same<typename std::remove_cv<typename std::remove_pointer<It>::type>::type, std::int32_t>::value ||
+		                                                              std::is_same<typename std::make_signed<typename std::remove_cv<typename std::remove_pointer<It>::type>::type>::type, std::int64_t>::value>
+		{};
+
+	  // software prefetches run this many elements ahead of the indirect accesses in gather and scatter
+	  constexpr std::size_t prefetch_distance{32};
+
+	  // iterator versions, pointers to float or double go to the kernels above and everything else runs a plain loop
+	  template <class precision_type, class InputIt, class OutputIt>
+		HOST void saxpy(const precision_type a, InputIt x, OutputIt y, const std::size_t n_elements);
+	  template <class InputIt, class OutputIt>
+		HOST void copy(InputIt x, OutputIt y, const std::size_t n_elements);
+	  template <class ForwardIt, class T>
+		HOST void replace(ForwardIt x, const std::size_t n_elements, const T & old_value, const T & new_value);
+	  template <class InputIt, class T>
+		HOST T accumulate(InputIt x, const std::size_t n_elements, T init);
+	  template <class InputIt1, class InputIt2, class T>
+		HOST T inner_product(InputIt1 x, InputIt2 y, const std::size_t n_elements, T init);
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type kahan_sum(InputIt x, const std::size_t n_elements);
+	  template <class InputIt>
+		HOST typename std::iterator_traits<InputIt>::value_type neumaier_sum(InputIt x, const std::size_t n_elements);
+	  // the hardware gathers already keep many loads in flight so only the plain loop prefetches the elements it is about to load
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void gather(InputIt x, IndexIt index, OutputIt y, const std::size_t n_elements);
+	  // y[index[i]] = x[i] in order of i so a repeated index keeps its last value, the destinations are prefetched for writing
+	  // as the stores to missing lines would otherwise fill the store buffer
+	  template <class InputIt, class IndexIt, class OutputIt>
+		HOST void scatter(InputIt x, IndexIt index, OutputIt y, const std::size_t n_elements);
+	  // streaming versions for pointers to trivial types, everything else goes through the cache
+	  template <class InputIt, class OutputIt>
+		HOST void stream_copy(InputIt x, OutputIt y, const std::size_t n_elements);
+	  template <class OutputIt, class T>
+		HOST void stream_fill(OutputIt x, const std::size_t n_elements, const T & value);
+	  // g is called in order, its values are staged in a small cached block that is then streamed out
+	  template <class OutputIt, class Generator>
+		HOST void stream_generate(OutputIt x, const std::size_t n_elements, Generator g);
+	}// END NAMESPACE SIMD
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/simd.tcc>
+#endif
@@ -0,0 +1,88 @@
+#ifndef SLOT_MAP_HH
+#define SLOT_MAP_HH
+#include <multi_core/macros.hh>
+#include <vector>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	// identifies a value in a slot_map, a handle goes stale once its value is erased even if the slot is reused
+	class slot_handle
+	{
+	  public:
+		HOST slot_handle()
+		  : index(std::numeric_limits<std::uint32_t>::max()), generation(0)
+		{}
+		HOST slot_handle(std::uint32_t index, std::uint32_t generation)
+		  : index(index), generation(generation)
+		{}
+		HOST std::uint32_t get_index()const
+		{ return index; }
+		HOST std::uint32_t get_generation()const
+		{ return generation; }
+		HOST bool operator == (const slot_handle & sh)const
+		{ return index == sh.index && generation == sh.generation; }
+		HOST bool operator != (const slot_handle & sh)const
+		{ return !(*this == sh); }
+	  private:
+		std::uint32_t index;
+		std::uint32_t generation;
+	};
+
+	// a vector of reusable slots, erased slots are put on a free list and handed out again by insert,
+	// so memory is bounded by the largest number of values alive at once rather than the number ever inserted
+	template <class T>
+	  class slot_map
+	  {
+		public:
+		  HOST slot_map() = default;
+		  HOST slot_map(const slot_map&) = delete;
+		  HOST slot_map(slot_map&&) = delete;
+		  HOST slot_map & operator =(const slot_map&) = delete;
+		  HOST slot_map & operator =(slot_map&&) = delete;
+		  HOST ~slot_map();
+		  HOST slot_handle insert(T && value);
+		  // true if the handle still refers to a live value
+		  HOST bool contains(const slot_handle & handle)const;
+		  // throws std::out_of_range on a stale handle
+		  HOST T & at(const slot_handle & handle);
+		  HOST void erase(const slot_handle & handle);
+		  HOST void clear();
+		  // live values
+		  HOST std::uint32_t size()const;
+		  // live values plus free slots
+		  HOST std::uint32_t capacity()const;
+		  // calls f on every live value
+		  template <class UnaryFunction>
+			HOST void for_each(UnaryFunction f);
+		private:
+		  class slot
+		  {
+			public:
+			  HOST slot();
+			  HOST slot(slot && s);
+			  HOST slot(const slot&) = delete;
+			  HOST slot & operator =(const slot&) = delete;
+			  HOST slot & operator =(slot&&) = delete;
+			  HOST ~slot();
+			  HOST void construct(T && value);
+			  HOST void destroy();
+			  HOST T & value();
+			  HOST bool occupied()const;
+			  HOST std::uint32_t get_generation()const;
+			private:
+			  typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+			  std::uint32_t generation;
+			  bool is_occupied;
+		  };
+		  std::vector<slot> slots;
+		  std::vector<std::uint32_t> free_slots;
+	  };
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/slot_map.tcc>
+#endif
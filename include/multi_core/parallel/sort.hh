@@ -0,0 +1,45 @@
+#ifndef ZINHART_SORT_HH
+#define ZINHART_SORT_HH
+#include <multi_core/parallel/fork_join.hh>
+#include <functional>
+#include <iterator>
+#include <vector>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	/*
+	 * Parallel merge sort. Each chunk is sorted with std::sort (std::stable_sort for stable_sort), then the sorted runs are merged pairwise
+	 * through a buffer of the same size. Every merge round splits its output evenly over all chunks with a merge path search,
+	 * so the last round, a single merge, is still done by every worker. Elements must be default constructible and movable.
+	 * */
+	namespace parallel
+	{
+	  template <class RandomIt>
+		HOST void sort(RandomIt first, RandomIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class RandomIt, class Compare>
+		HOST void sort(RandomIt first, RandomIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class RandomIt>
+		HOST void stable_sort(RandomIt first, RandomIt last, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  template <class RandomIt, class Compare>
+		HOST void stable_sort(RandomIt first, RandomIt last, Compare comp, thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+
+	  // the number of elements of the sorted ranges a[0, a_size) and b[0, b_size) that come from a among the first k outputs of a stable merge
+	  template <class RandomIt1, class RandomIt2, class Compare>
+		HOST std::size_t merge_path(const std::size_t k, RandomIt1 a, const std::size_t a_size, RandomIt2 b, const std::size_t b_size, Compare comp);
+
+	  // merges neighbouring runs of source, run i is [bounds[i], bounds[i + 1]), into destination, an odd run out is moved across unchanged
+	  template <class SourceIt, class DestinationIt, class Compare>
+		HOST void merge_round(SourceIt source, DestinationIt destination, const std::vector<std::size_t> & bounds, Compare comp, thread_pool::scheduler & scheduler);
+
+	  // the engine behind sort and stable_sort
+	  template <class RandomIt, class Compare>
+		HOST void merge_sort(RandomIt first, RandomIt last, Compare comp, const bool stable, thread_pool::scheduler & scheduler);
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/parallel/ext/sort.tcc>
+#endif
@@ -1,11 +1,29 @@
 #ifndef TASK_MANAGER_HH
 #define TASK_MANAGER_HH
 #include <multi_core/parallel/thread_pool.hh>
+#include <multi_core/parallel/slot_map.hh>
+#include <memory>
+#include <stdexcept>
 #include <iostream>
 namespace zinhart
 {
   namespace multi_core
   {
+	// selects the task_manager specialization whose tasks may each return a different type
+	class heterogeneous
+	{};
+
+	// a slot_handle that remembers the result type of the task it refers to
+	template <class T>
+	  class task_handle : public slot_handle
+	  {
+		public:
+		  HOST task_handle() = default;
+		  HOST explicit task_handle(const slot_handle & handle)
+			: slot_handle(handle)
+		  {}
+	  };
+
 	template<class T>
 	  class task_manager
 	  {
@@ -62,27 +80,133 @@ namespace zinhart
 		  HOST task_manager(task_manager&&) = delete;
 		  HOST task_manager & operator =(const task_manager&) = delete;
 		  HOST task_manager & operator =(task_manager&&) = delete;
-		  HOST task_manager(std::uint32_t n_threads = std::max(1U, MAX_CPU_THREADS - 1));
+		  // runs tasks on a private scheduler with n_threads workers
+		  HOST task_manager(std::uint32_t n_threads);
+		  // shares the workers of an existing scheduler, the process wide one by default
+		  HOST task_manager(thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
 		  HOST ~task_manager(); 
-		  HOST T get(std::uint64_t index);	
-		  HOST bool valid(std::uint64_t index);
+		  // consumes the result, after which the handle is stale and its slot is reused by a later push
+		  HOST T get(const slot_handle & handle);	
+		  // false once the result has been consumed
+		  HOST bool valid(const slot_handle & handle)const;
+		  // resizes a private scheduler, throws std::logic_error for a shared one since resizing it would change every other user's pool
 		  HOST void resize(std::uint64_t n_threads);
 		  HOST std::uint64_t size()const;
+		  // tasks whose result has not been consumed
+		  HOST std::uint64_t pending()const;
 		  template<class Callable, class ... Args>
 			HOST T push_wait(std::uint64_t priority, Callable && c, Args&&...args);
 		  template<class Callable, class ... Args>
-			HOST void push(std::uint64_t priority, Callable && c, Args&&...args);
+			HOST slot_handle push(std::uint64_t priority, Callable && c, Args&&...args);
 		  HOST void push(task && t);
+		  // replaces the pending task referred to by at, discarding its result, next_completed reports at once the replacement has run
 		  template<class Callable, class ... Args>
-			HOST void push_at(std::uint64_t at, std::uint64_t priority, Callable && c, Args&&...args);
+			HOST void push_at(const slot_handle & at, std::uint64_t priority, Callable && c, Args&&...args);
+		  // yields the handles of pushed tasks in the order they finish, blocking until one is available,
+		  // tasks already consumed with get are skipped and false is returned once every pushed task has been claimed
+		  HOST bool next_completed(slot_handle & handle);
+		  // same as above but also consumes the result of the finished task
+		  template <class Result = T>
+			HOST bool next_completed(slot_handle & handle, Result & result);
 
 		private:
-		  thread_pool::priority_pool thread_pool;
-		  std::vector< thread_pool::tasks::task_future<T> > pending_tasks;
+		  // a future and the push that produced it, push_at replaces both
+		  struct tracked_future
+		  {
+			thread_pool::tasks::task_future<T> future;
+			std::uint64_t push_id;
+		  };
+		  // the handle of a task that has run and the push that produced it, so the completion of a task discarded by push_at can be told apart from its replacement's
+		  struct completion
+		  {
+			slot_handle handle;
+			std::uint64_t push_id;
+		  };
+		  // wraps a task so that its completion is published to completed_tasks once it has run
+		  template <class Bound>
+			class completion_notifier
+			{
+			  private:
+				class publisher
+				{
+				  public:
+					publisher(const completion & done, thread_safe_queue<completion> & completed_tasks)
+					  : done(done), completed_tasks(completed_tasks)
+					{}
+					// also runs when the task throws so that next_completed never waits on it forever
+					~publisher()
+					{ completed_tasks.push(done); }
+				  private:
+					completion done;
+					thread_safe_queue<completion> & completed_tasks;
+				};
+				Bound bound;
+				completion done;
+				thread_safe_queue<completion> & completed_tasks;
+			  public:
+				completion_notifier(Bound && bound, const completion & done, thread_safe_queue<completion> & completed_tasks)
+				  : bound(std::move(bound)), done(done), completed_tasks(completed_tasks)
+				{}
+				completion_notifier(completion_notifier &&) = default;
+				T operator()()
+				{
+				  publisher p(done, completed_tasks);
+				  return bound();
+				}
+			};
+		  template<class Callable, class ... Args>
+			HOST tracked_future add_task(const slot_handle & handle, std::uint64_t priority, Callable && c, Args&&...args);
+		  HOST void drain_completions();
+		  thread_safe_queue<completion> completed_tasks;
+		  // identifies each push, a completion only counts while its push_id matches the one stored in its slot
+		  std::uint64_t next_push_id;
+		  // pushes whose handle has not yet been taken off of completed_tasks,
+		  // once this drops to zero no task will touch completed_tasks again
+		  std::uint64_t unclaimed_completions;
+		  // only set when constructed with a thread count
+		  std::unique_ptr<thread_pool::scheduler> private_thread_pool;
+		  thread_pool::scheduler & thread_pool;
+		  // consumed slots are recycled so this only grows with the number of unconsumed tasks
+		  slot_map<tracked_future> pending_tasks;
 		  std::vector<task> pending_tasks_new;
 
 
 	  };
+
+	// one pool serving tasks of any result type, each result is left in its future until get moves it out
+	template<>
+	  class task_manager<heterogeneous>
+	  {
+		public:
+		  HOST task_manager(const task_manager&) = delete;
+		  HOST task_manager(task_manager&&) = delete;
+		  HOST task_manager & operator =(const task_manager&) = delete;
+		  HOST task_manager & operator =(task_manager&&) = delete;
+		  // runs tasks on a private scheduler with n_threads workers
+		  HOST task_manager(std::uint32_t n_threads);
+		  // shares the workers of an existing scheduler, the process wide one by default
+		  HOST task_manager(thread_pool::scheduler & scheduler = thread_pool::get_scheduler());
+		  HOST ~task_manager(); 
+		  // consumes the result, after which the handle is stale and its slot is reused by a later push
+		  template <class T>
+			HOST T get(const task_handle<T> & handle);	
+		  // false once the result has been consumed
+		  HOST bool valid(const slot_handle & handle)const;
+		  // resizes a private scheduler, throws std::logic_error for a shared one since resizing it would change every other user's pool
+		  HOST void resize(std::uint64_t n_threads);
+		  HOST std::uint64_t size()const;
+		  // tasks whose result has not been consumed
+		  HOST std::uint64_t pending()const;
+		  template<class Callable, class ... Args>
+			HOST auto push_wait(std::uint64_t priority, Callable && c, Args&&...args) -> typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type;
+		  template<class Callable, class ... Args>
+			HOST auto push(std::uint64_t priority, Callable && c, Args&&...args) -> task_handle<typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type>;
+		private:
+		  // only set when constructed with a thread count
+		  std::unique_ptr<thread_pool::scheduler> private_thread_pool;
+		  thread_pool::scheduler & thread_pool;
+		  slot_map<thread_pool::tasks::any_task_future> pending_tasks;
+	  };
   }// END NAMESPACE MULTI_CORE
 }// END NAMESPACE ZINHART
 #include <multi_core/parallel/ext/task_manager.tcc>
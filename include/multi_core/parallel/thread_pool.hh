@@ -5,11 +5,15 @@
 #include <future>
 #include <functional>
 #include <vector>
+#include <atomic>
+#include <memory>
 #include <multi_core/macros.hh>
 #include <multi_core/parallel/thread_safe_queue.hh>
 #include <multi_core/parallel/thread_safe_priority_queue.hh>
 #include <functional>
 #include <type_traits>
+#include <limits>
+#include <new>
 namespace zinhart
 {
   namespace multi_core
@@ -32,6 +36,9 @@ namespace zinhart
 			  {  }
 			  HOST virtual std::uint64_t get_priority()const
 			  { return 0; }
+			  // submission order, used to keep tasks of equal priority first in first out
+			  HOST virtual std::uint64_t get_sequence()const
+			  { return 0; }
 			  thread_task_interface(const thread_task_interface&) = delete;
 			  thread_task_interface & operator =(const thread_task_interface&) = delete;
 
@@ -80,6 +87,45 @@ namespace zinhart
 				  priority_thread_task & operator =(const priority_thread_task&) = delete;
 			};
 
+		  template <class Callable>
+			class scheduled_thread_task : public thread_task_interface
+			{
+			  private:
+				  Callable callable;
+				  std::uint64_t sequence;
+				  using thread_task_interface::priority;
+			  public:
+				  HOST scheduled_thread_task(std::uint64_t priority, std::uint64_t sequence, Callable && c)
+				  {	
+					this->priority = priority;
+					this->sequence = sequence;
+					this->callable = std::move(c); 
+				  }
+				  scheduled_thread_task & operator =(scheduled_thread_task&&) = default;
+				  virtual ~scheduled_thread_task() = default;
+				  HOST void operator()() override
+				  { this->callable(); }
+				  HOST virtual std::uint64_t get_priority() const override
+				  { return priority; }
+				  HOST virtual std::uint64_t get_sequence() const override
+				  { return sequence; }
+
+				  scheduled_thread_task(const scheduled_thread_task&) = delete;
+				  scheduled_thread_task & operator =(const scheduled_thread_task&) = delete;
+			};
+
+		  // highest priority first, then oldest first
+		  class scheduling_order
+		  {
+			public:
+			  HOST bool operator()(const std::shared_ptr<thread_task_interface> & lhs, const std::shared_ptr<thread_task_interface> & rhs)const
+			  {
+				if(lhs->get_priority() != rhs->get_priority())
+				  return lhs->get_priority() < rhs->get_priority();
+				return lhs->get_sequence() > rhs->get_sequence();
+			  }
+		  };
+
 
 		  template <class T>
 			class task_future
@@ -103,6 +149,55 @@ namespace zinhart
 				  HOST T get()
 				  { return future.get(); }
 			};
+
+		  // a task_future of any result type, stored in place rather than behind another allocation
+		  class any_task_future
+		  {
+			private:
+			  template <class T>
+				class operations
+				{
+				  public:
+					HOST static void move(void * from, void * to)
+					{ new (to) task_future<T>(std::move(*static_cast<task_future<T>*>(from))); }
+					HOST static void destroy(void * future)
+					{ static_cast<task_future<T>*>(future)->~task_future<T>(); }
+					HOST static bool valid(void * future)
+					{ return static_cast<task_future<T>*>(future)->valid(); }
+				};
+			  // every task_future is a single std::future, which is the same size whatever the result type
+			  typename std::aligned_storage<sizeof(task_future<void>), std::alignment_of<task_future<void>>::value>::type storage;
+			  void (*move_future)(void *, void *);
+			  void (*destroy_future)(void *);
+			  bool (*valid_future)(void *);
+			public:
+			  template <class T>
+				HOST any_task_future(task_future<T> && future)
+				  : move_future(&operations<T>::move), destroy_future(&operations<T>::destroy), valid_future(&operations<T>::valid)
+				{
+				  static_assert(sizeof(task_future<T>) <= sizeof(storage), "task_future<T> does not fit in any_task_future");
+				  new (&storage) task_future<T>(std::move(future));
+				}
+			  HOST any_task_future(any_task_future && f)
+				: move_future(f.move_future), destroy_future(f.destroy_future), valid_future(f.valid_future)
+			  { move_future(&f.storage, &storage); }
+			  HOST any_task_future(const any_task_future&) = delete;
+			  HOST any_task_future & operator =(const any_task_future&) = delete;
+			  HOST any_task_future & operator =(any_task_future&&) = delete;
+			  // waits on the task like task_future does
+			  HOST ~any_task_future()
+			  { destroy_future(&storage); }
+			  HOST bool valid()
+			  { return valid_future(&storage); }
+			  // true if this was constructed from a task_future<T>
+			  template <class T>
+				HOST bool holds()const
+				{ return destroy_future == &operations<T>::destroy; }
+			  // unchecked, see holds
+			  template <class T>
+				HOST task_future<T> & get_future()
+				{ return *reinterpret_cast<task_future<T>*>(&storage); }
+		  };
 		}// END NAMESPACE TASKS
 		
 
@@ -185,27 +280,85 @@ namespace zinhart
 			HOST void down();
 			HOST void work();
 		};
+	  // one set of workers serving both first in first out and prioritized tasks,
+	  // first in first out tasks have the lowest priority and run in submission order
+	  template <>
+		class thread_pool<thread_safe_priority_queue<std::shared_ptr<tasks::thread_task_interface>, std::vector<std::shared_ptr<tasks::thread_task_interface>>, tasks::scheduling_order>>
+		{
+		  public:
+			HOST void down();
+			// disable everthing
+			HOST thread_pool(const thread_pool&) = delete;
+			HOST thread_pool(thread_pool&&) = delete;
+			HOST thread_pool & operator =(const thread_pool&) = delete;
+			HOST thread_pool & operator =(thread_pool&&) = delete;
+			HOST thread_pool(std::uint32_t n_threads = std::max(1U, MAX_CPU_THREADS - 1));
+			HOST ~thread_pool(); 
+			HOST std::uint32_t size() const;
+			HOST void resize(std::uint32_t size);
+			
+			template<class Callable, class ... Args>
+			  HOST auto add_task(Callable && c, Args&&...args) -> tasks::task_future<typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type >
+			  { return add_priority_task(0, std::forward<Callable>(c), std::forward<Args>(args)...); }
+
+			template<class Callable, class ... Args>
+			  HOST auto add_priority_task(std::uint64_t priority, Callable && c, Args&&...args) -> tasks::task_future< typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type >
+			  {
+				auto bound_task     = std::bind(std::forward<Callable>(c), std::forward<Args>(args)...); 
+				using result_type   = typename std::result_of<decltype(bound_task)()>::type;
+				using packaged_task = std::packaged_task<result_type()>;
+				using task_type     = tasks::scheduled_thread_task<packaged_task>;
+				packaged_task task{std::move(bound_task)};
+				tasks::task_future<result_type> result{task.get_future()};
+				queue.push(std::make_shared<task_type>(priority, sequence++, std::move(task)));
+				return result;
+			  }
+
+			// queues the same callable n_copies times ahead of everything else, under one lock and without futures,
+			// so the callable must be safe to run concurrently and must report its own completion
+			template<class Callable>
+			  HOST void add_batch(std::uint32_t n_copies, Callable && c)
+			  {
+				using task_type = tasks::scheduled_thread_task<typename std::decay<Callable>::type>;
+				typename std::decay<Callable>::type callable(std::forward<Callable>(c));
+				queue.push_n(std::make_shared<task_type>(std::numeric_limits<std::uint64_t>::max(), sequence++, std::move(callable)), n_copies);
+			  }
+
+		  private:
+			THREAD_POOL_STATE thread_pool_state;
+			std::vector<std::thread> threads;
+			std::atomic<std::uint64_t> sequence;
+			thread_safe_priority_queue< std::shared_ptr<tasks::thread_task_interface>, std::vector<std::shared_ptr<tasks::thread_task_interface>>, tasks::scheduling_order > queue;
+			HOST void up(const std::uint32_t & n_threads);
+			HOST void work();
+		};
+
 	  using pool = thread_pool< thread_safe_queue< std::shared_ptr<tasks::thread_task_interface> > >;
 	  using priority_pool = thread_pool< thread_safe_priority_queue< std::shared_ptr<tasks::thread_task_interface> > >;
+	  using scheduler = thread_pool< thread_safe_priority_queue< std::shared_ptr<tasks::thread_task_interface>, std::vector<std::shared_ptr<tasks::thread_task_interface>>, tasks::scheduling_order > >;
 
+	  // the process wide workers behind push_task and priority_thread_pool::push_task
+	  scheduler & get_scheduler();
 
+	  // a dedicated pool with its own workers, prefer get_scheduler unless the tasks must be isolated
 	  pool & get_thread_pool();
 	  void resize(std::uint32_t n_threads);
 	  const std::uint32_t size();
 
 	  template <class Callable, class ... Args>
 		auto push_task(Callable && c, Args&&...args) -> tasks::task_future<typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type >	
-		{ return get_thread_pool().add_task(std::forward<Callable>(c), std::forward<Args>(args)...); }
+		{ return get_scheduler().add_task(std::forward<Callable>(c), std::forward<Args>(args)...); }
 	  
 	  namespace priority_thread_pool
 	  {
+		// a dedicated pool with its own workers, prefer get_scheduler unless the tasks must be isolated
 		priority_pool & get_priority_thread_pool();
 		void resize(std::uint32_t n_threads);
 		const std::uint32_t size();
 
 		template <class Callable, class ... Args>
 		  auto push_task(std::uint64_t priority, Callable && c, Args&&...args) -> tasks::task_future<typename std::result_of<decltype(std::bind(std::forward<Callable>(c), std::forward<Args>(args)...))()>::type >	
-		  { return get_priority_thread_pool().add_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...); }
+		  { return get_scheduler().add_priority_task(priority, std::forward<Callable>(c), std::forward<Args>(args)...); }
 	  }
 
 	}// END NAMESPACE THREAD_POOL
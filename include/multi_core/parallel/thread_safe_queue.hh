@@ -22,13 +22,18 @@ namespace zinhart
 		  HOST ~thread_safe_queue();
 		  HOST void push(const T & item);
 		  HOST void push(T && item);
+		  // pushes n_copies of item under a single lock
+		  HOST void push_n(const T & item, std::uint32_t n_copies);
 		  // item only contains the value popped from the queue if the queue is not empty
 		  HOST bool pop(T & item);
 		  // blocks until queue.size() > 0
 		  HOST bool pop_on_available(T & item);
-		  // i.e pending items
-		  HOST std::uint32_t size();
-		  HOST bool empty();
+		  // i.e pending items, these are lock free and may be stale by the time they return
+		  HOST std::uint32_t size() const;
+		  HOST bool empty() const;
+		  // same as above but taken under the queue lock
+		  HOST std::uint32_t size_exact();
+		  HOST bool empty_exact();
 		  HOST void clear();
 		  HOST void wakeup();
 		  //manually shutdown the queue
@@ -39,6 +44,10 @@ namespace zinhart
 		  std::queue<T, Container> queue;
 		  std::condition_variable cv;
 		  QUEUE_STATE queue_state;
+		  // element count kept on its own cache line so that readers of size() and empty() do not contend with push and pop
+		  char count_front_padding[CACHE_LINE_SIZE];
+		  std::atomic<std::uint32_t> count;
+		  char count_back_padding[CACHE_LINE_SIZE - sizeof(std::atomic<std::uint32_t>)];
 	  };
   }// END NAMESPACE MULTI_CORE
 }// END NAMESPACE ZINHART
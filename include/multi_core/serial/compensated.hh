@@ -0,0 +1,28 @@
+#ifndef ZINHART_COMPENSATED_HH
+#define ZINHART_COMPENSATED_HH
+#include <multi_core/macros.hh>
+#include <cstddef>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	// independent compensated sums kept by the portable and serial sums, enough to hide the latency of the adds
+	constexpr std::size_t compensated_lanes{8};
+	// one neumaier compensation step, sum becomes the rounded sum + value and its rounding error is added to correction,
+	// that add is itself rounded so the error left in correction grows with the number of steps
+	template <class precision_type>
+	  HOST void neumaier_step(precision_type & sum, precision_type & correction, const precision_type value);
+	// compensated sums of element(0) ... element(n_elements - 1) for any type, each lane keeps its own sum and compensation and the lanes are folded at the end
+	template <class precision_type, class Element>
+	  HOST precision_type kahan_lanes(Element element, const std::size_t n_elements);
+	template <class precision_type, class Element>
+	  HOST precision_type neumaier_lanes(Element element, const std::size_t n_elements);
+	// unrounded, the total is the returned sum + correction
+	template <class precision_type, class Element>
+	  HOST precision_type kahan_lanes(Element element, const std::size_t n_elements, precision_type & correction);
+	template <class precision_type, class Element>
+	  HOST precision_type neumaier_lanes(Element element, const std::size_t n_elements, precision_type & correction);
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#include <multi_core/serial/ext/compensated.tcc>
+#endif
@@ -0,0 +1,86 @@
+#ifndef ZINHART_COMPENSATED_TCC
+#define ZINHART_COMPENSATED_TCC
+#include <cmath>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	template <class precision_type>
+	  HOST void neumaier_step(precision_type & sum, precision_type & correction, const precision_type value)
+	  {
+		const precision_type t{sum + value};
+		if(std::abs(sum) >= std::abs(value))
+		  // if the sum is bigger lower order digits of value are lost
+		  correction += (sum - t) + value;
+		else
+		  // if the sum is smaller lower order digits of sum are lost
+		  correction += (value - t) + sum;
+		sum = t;
+	  }
+
+	template <class precision_type, class Element>
+	  HOST precision_type kahan_lanes(Element element, const std::size_t n_elements, precision_type & correction)
+	  {
+		precision_type sum[compensated_lanes] = {}, compensation[compensated_lanes] = {};
+		std::size_t op{0};
+		for(; op + compensated_lanes <= n_elements; op += compensated_lanes)
+		  for(std::size_t lane = 0; lane < compensated_lanes; ++lane)
+		  {
+			const precision_type y{element(op + lane) - compensation[lane]};
+			// lower order bits are lost here with this addition
+			const precision_type t{sum[lane] + y};
+			// (t - sum) cancels the higher order part of y and subtracting y recovers the low part of y
+			compensation[lane] = (t - sum[lane]) - y;
+			sum[lane] = t;
+		  }
+		// kahan keeps the negated correction
+		precision_type total{0};
+		correction = 0;
+		for(std::size_t lane = 0; lane < compensated_lanes; ++lane)
+		{
+		  neumaier_step(total, correction, sum[lane]);
+		  correction -= compensation[lane];
+		}
+		for(; op < n_elements; ++op)
+		  neumaier_step(total, correction, precision_type(element(op)));
+		return total;
+	  }
+
+	template <class precision_type, class Element>
+	  HOST precision_type neumaier_lanes(Element element, const std::size_t n_elements, precision_type & correction)
+	  {
+		precision_type sum[compensated_lanes] = {}, compensation[compensated_lanes] = {};
+		std::size_t op{0};
+		for(; op + compensated_lanes <= n_elements; op += compensated_lanes)
+		  for(std::size_t lane = 0; lane < compensated_lanes; ++lane)
+			neumaier_step(sum[lane], compensation[lane], precision_type(element(op + lane)));
+		precision_type total{0};
+		correction = 0;
+		for(std::size_t lane = 0; lane < compensated_lanes; ++lane)
+		{
+		  neumaier_step(total, correction, sum[lane]);
+		  correction += compensation[lane];
+		}
+		for(; op < n_elements; ++op)
+		  neumaier_step(total, correction, precision_type(element(op)));
+		return total;
+	  }
+
+	template <class precision_type, class Element>
+	  HOST precision_type kahan_lanes(Element element, const std::size_t n_elements)
+	  {
+		precision_type correction;
+		const precision_type sum{kahan_lanes<precision_type>(element, n_elements, correction)};
+		return sum + correction;
+	  }
+
+	template <class precision_type, class Element>
+	  HOST precision_type neumaier_lanes(Element element, const std::size_t n_elements)
+	  {
+		precision_type correction;
+		const precision_type sum{neumaier_lanes<precision_type>(element, n_elements, correction)};
+		return sum + correction;
+	  }
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
+#endif
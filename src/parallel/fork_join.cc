@@ -0,0 +1,76 @@
+#include <multi_core/parallel/fork_join.hh>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace parallel
+	{
+	  HOST std::size_t default_chunks(const std::size_t n_elements, thread_pool::scheduler & scheduler)
+	  { return std::min(n_elements, std::size_t{scheduler.size()} + 1); }
+
+	  HOST std::size_t auto_chunks(const std::size_t n_elements, const std::size_t bytes_per_element, thread_pool::scheduler & scheduler)
+	  { return chunk_plan(auto_schedule(bytes_per_element), n_elements, scheduler.size() + 1).size(); }
+
+	  HOST schedule auto_schedule(const std::size_t bytes_per_element)
+	  { return schedule(schedule_kind::auto_chunks, std::max(min_bytes_per_task / std::max(bytes_per_element, std::size_t{1}), std::size_t{1})); }
+
+	  HOST schedule::schedule(const schedule_kind kind, const std::size_t grain)
+		: kind(kind), grain(std::max(grain, std::size_t{1}))
+	  {}
+
+	  HOST schedule_kind schedule::get_kind()const
+	  { return kind; }
+
+	  HOST std::size_t schedule::get_grain()const
+	  { return grain; }
+
+	  HOST chunk_plan::chunk_plan(const schedule & policy, const std::size_t n_elements, const std::size_t n_participants)
+		: kind(policy.get_kind()), n_elements(n_elements), grain(policy.get_grain()), n_chunks(0)
+	  {
+		const std::size_t participants{std::max(n_participants, std::size_t{1})};
+		if(kind == schedule_kind::static_chunks)
+		  n_chunks = std::min(n_elements, participants);
+		else if(kind == schedule_kind::auto_chunks)
+		  n_chunks = std::min(std::min(n_elements, participants), std::max(n_elements / grain, std::size_t{1}));
+		else if(kind == schedule_kind::dynamic_chunks)
+		  n_chunks = n_elements / grain + (n_elements % grain != 0);
+		else
+		{
+		  // each chunk takes half of an even share of what is left, but never less than grain
+		  std::size_t start{0};
+		  while(start < n_elements)
+		  {
+			bounds.push_back(start);
+			const std::size_t remaining{n_elements - start};
+			const std::size_t share{(remaining + 2 * participants - 1) / (2 * participants)};
+			start += std::min(remaining, std::max(share, grain));
+		  }
+		  bounds.push_back(n_elements);
+		  n_chunks = bounds.size() - 1;
+		}
+	  }
+
+	  HOST std::size_t chunk_plan::size()const
+	  { return n_chunks; }
+
+	  HOST std::size_t chunk_plan::get_n_elements()const
+	  { return n_elements; }
+
+	  HOST void chunk_plan::range(const std::size_t chunk_id, std::size_t & start, std::size_t & stop)const
+	  {
+		if(kind == schedule_kind::static_chunks || kind == schedule_kind::auto_chunks)
+		  zinhart::multi_core::map(static_cast<std::uint32_t>(chunk_id), static_cast<std::uint32_t>(n_chunks), n_elements, start, stop);
+		else if(kind == schedule_kind::dynamic_chunks)
+		{
+		  start = chunk_id * grain;
+		  stop = start + std::min(grain, n_elements - start);
+		}
+		else
+		{
+		  start = bounds[chunk_id];
+		  stop = bounds[chunk_id + 1];
+		}
+	  }
+	}// END NAMESPACE PARALLEL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
@@ -0,0 +1,49 @@
+#include <multi_core/parallel/random.hh>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace random
+	{
+	  HOST philox4x32::philox4x32(const std::uint64_t seed, const std::uint64_t stream)
+	  { this->seed(seed, stream); }
+
+	  HOST void philox4x32::seed(const std::uint64_t seed, const std::uint64_t stream)
+	  {
+		key = seed;
+		this->stream = stream;
+		position = 0;
+		buffered_block = std::numeric_limits<std::uint64_t>::max();
+	  }
+
+	  HOST std::uint64_t philox4x32::get_seed()const
+	  { return key; }
+
+	  HOST std::uint64_t philox4x32::get_stream()const
+	  { return stream; }
+
+	  HOST void philox4x32::blocks(const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks)const
+	  { simd::philox4x32_blocks(key, stream, first_counter, bits, n_blocks); }
+
+	  HOST philox4x32::result_type philox4x32::operator()()
+	  {
+		const std::uint64_t block{position / block_words};
+		if(block != buffered_block)
+		{
+		  blocks(block, buffer, 1);
+		  buffered_block = block;
+		}
+		return buffer[position++ % block_words];
+	  }
+
+	  HOST void philox4x32::discard(const unsigned long long z)
+	  { position += z; }
+
+	  HOST bool philox4x32::operator == (const philox4x32 & engine)const
+	  { return key == engine.key && stream == engine.stream && position == engine.position; }
+
+	  HOST bool philox4x32::operator != (const philox4x32 & engine)const
+	  { return !(*this == engine); }
+	}// END NAMESPACE RANDOM
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
@@ -0,0 +1,82 @@
+#include <multi_core/parallel/thread_pool.hh>
+#include <iostream>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace thread_pool
+	{
+	  HOST void scheduler::up(const std::uint32_t & n_threads)
+	  {
+		try
+		{
+		  queue.wakeup();
+		  // set the queue state for work
+		  thread_pool_state = THREAD_POOL_STATE::UP;
+		  for(std::uint32_t i = 0; i < n_threads; ++i )
+		   threads.emplace_back(&scheduler::work, this);
+		}
+		catch(...)
+		{
+			down();
+			throw;
+		}
+	  }	
+
+	  HOST void scheduler::work()
+	  {
+		std::shared_ptr<tasks::thread_task_interface> task;
+		while(thread_pool_state != THREAD_POOL_STATE::DOWN)
+		  if(queue.pop_on_available(task))
+			(*task)();	  
+	  }
+
+	  HOST void scheduler::down()
+	  {
+		thread_pool_state = THREAD_POOL_STATE::DOWN;
+		queue.shutdown();
+		for(std::thread & t : threads)
+		  if(t.joinable())
+			t.join();
+		threads.clear();
+	  }
+
+	  HOST void scheduler::resize(std::uint32_t n_threads)
+	  { 
+		try
+		{
+		  if(n_threads == 0)
+			throw std::runtime_error("cannot have 0 threads");
+		  down();
+		  up(n_threads);
+		}
+		catch(std::runtime_error & e)
+		{
+		  std::cout<<e.what()<<"\n";
+		  std::abort();
+		}
+		catch(std::exception & e)
+		{
+		  std::cout<<e.what()<<"\n";
+		  std::abort();
+		}
+	  }
+
+	  HOST scheduler::thread_pool(std::uint32_t n_threads)
+		: sequence(0)
+	  { up(n_threads); }
+
+	  HOST scheduler::~thread_pool()
+	  { down(); }
+
+	  HOST std::uint32_t scheduler::size() const
+	  { return threads.size(); }
+
+	  scheduler & get_scheduler()
+	  {
+		static scheduler thread_pool;
+		return thread_pool;
+	  }
+	}// END NAMESPACE THREAD_POOL
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
@@ -0,0 +1,771 @@
+#include <multi_core/parallel/simd.hh>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+// the kernels are written once with gcc vector extensions and inlined into one entry point per instruction set, the target attribute on the
+// entry point decides which instructions the inlined kernel is compiled to
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define MULTI_CORE_SIMD_X86 1
+  #define MULTI_CORE_TARGET(isa) __attribute__((target(isa)))
+#else
+  #define MULTI_CORE_SIMD_X86 0
+  #define MULTI_CORE_TARGET(isa)
+#endif
+#define MULTI_CORE_INLINE inline __attribute__((always_inline))
+#if MULTI_CORE_SIMD_X86
+  #include <immintrin.h>
+#endif
+namespace zinhart
+{
+  namespace multi_core
+  {
+	namespace simd
+	{
+	  // a register of T, unaligned and allowed to alias T
+	  template <class T, std::size_t bytes>
+		struct lanes
+		{
+		  typedef T type __attribute__((vector_size(bytes), aligned(sizeof(T)), may_alias));
+		  static const std::size_t width = bytes / sizeof(T);
+		};
+
+	  // fills every lane with value, adding value to a zero register would turn -0 into +0
+	  template <class Register, class T>
+		MULTI_CORE_INLINE void broadcast(Register & lanes_out, const T value, const std::size_t width)
+		{
+		  for(std::size_t lane = 0; lane < width; ++lane)
+			lanes_out[lane] = value;
+		}
+
+	  // each kernel is a struct so that one set of entry points can run all of them, bytes is the register width
+	  struct saxpy_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static void run(const T a, const T * x, T * y, const std::size_t n_elements)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			const reg * x_lanes = reinterpret_cast<const reg *>(x);
+			reg * y_lanes = reinterpret_cast<reg *>(y);
+			reg a_lanes;
+			broadcast(a_lanes, a, width);
+			std::size_t op{0};
+			for(; op + width <= n_elements; op += width)
+			  y_lanes[op / width] = a_lanes * x_lanes[op / width] + y_lanes[op / width];
+			for(; op < n_elements; ++op)
+			  y[op] = a * x[op] + y[op];
+		  }
+	  };
+
+	  struct copy_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static void run(const T * x, T * y, const std::size_t n_elements)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			const reg * x_lanes = reinterpret_cast<const reg *>(x);
+			reg * y_lanes = reinterpret_cast<reg *>(y);
+			std::size_t op{0};
+			// two registers per iteration keep both load ports busy
+			for(; op + 2 * width <= n_elements; op += 2 * width)
+			{
+			  const reg first = x_lanes[op / width];
+			  const reg second = x_lanes[op / width + 1];
+			  y_lanes[op / width] = first;
+			  y_lanes[op / width + 1] = second;
+			}
+			for(; op < n_elements; ++op)
+			  y[op] = x[op];
+		  }
+	  };
+
+	  struct replace_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static void run(T * x, const std::size_t n_elements, const T old_value, const T new_value)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			reg * x_lanes = reinterpret_cast<reg *>(x);
+			reg old_lanes, new_lanes;
+			broadcast(old_lanes, old_value, width);
+			broadcast(new_lanes, new_value, width);
+			std::size_t op{0};
+			for(; op + width <= n_elements; op += width)
+			  x_lanes[op / width] = x_lanes[op / width] == old_lanes ? new_lanes : x_lanes[op / width];
+			for(; op < n_elements; ++op)
+			  if(x[op] == old_value)
+				x[op] = new_value;
+		  }
+	  };
+
+	  // four independent accumulators hide the latency of the adds
+	  struct accumulate_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static T run(const T * x, const std::size_t n_elements)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			const reg * x_lanes = reinterpret_cast<const reg *>(x);
+			reg sum[4] = {reg{}, reg{}, reg{}, reg{}};
+			std::size_t op{0};
+			for(; op + 4 * width <= n_elements; op += 4 * width)
+			  for(std::size_t i = 0; i < 4; ++i)
+				sum[i] += x_lanes[op / width + i];
+			for(; op + width <= n_elements; op += width)
+			  sum[0] += x_lanes[op / width];
+			const reg total = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+			T result{0};
+			for(std::size_t lane = 0; lane < width; ++lane)
+			  result += total[lane];
+			for(; op < n_elements; ++op)
+			  result += x[op];
+			return result;
+		  }
+	  };
+
+	  struct inner_product_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static T run(const T * x, const T * y, const std::size_t n_elements)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			const reg * x_lanes = reinterpret_cast<const reg *>(x);
+			const reg * y_lanes = reinterpret_cast<const reg *>(y);
+			reg sum[4] = {reg{}, reg{}, reg{}, reg{}};
+			std::size_t op{0};
+			for(; op + 4 * width <= n_elements; op += 4 * width)
+			  for(std::size_t i = 0; i < 4; ++i)
+				sum[i] += x_lanes[op / width + i] * y_lanes[op / width + i];
+			for(; op + width <= n_elements; op += width)
+			  sum[0] += x_lanes[op / width] * y_lanes[op / width];
+			const reg total = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+			T result{0};
+			for(std::size_t lane = 0; lane < width; ++lane)
+			  result += total[lane];
+			for(; op < n_elements; ++op)
+			  result += x[op] * y[op];
+			return result;
+		  }
+	  };
+
+	  // independent register pairs per compensated sum, each add has a latency of about four cycles so four chains keep the adder busy
+	  constexpr std::size_t compensated_registers{4};
+
+	  // folds every lane of the compensated register pairs and the scalar tail, returns the sum and leaves what it could not represent in remainder
+	  template <std::size_t bytes, class T>
+		MULTI_CORE_INLINE T fold(const typename lanes<T, bytes>::type * sum, const typename lanes<T, bytes>::type * correction, const T * x, std::size_t op, const std::size_t n_elements, T * remainder)
+		{
+		  T total{0}, total_correction{0};
+		  for(std::size_t i = 0; i < compensated_registers; ++i)
+			for(std::size_t lane = 0; lane < lanes<T, bytes>::width; ++lane)
+			{
+			  neumaier_step(total, total_correction, sum[i][lane]);
+			  total_correction += correction[i][lane];
+			}
+		  for(; op < n_elements; ++op)
+			neumaier_step(total, total_correction, x[op]);
+		  *remainder = total_correction;
+		  return total;
+		}
+
+	  template <class Register>
+		MULTI_CORE_INLINE void kahan_add(Register & sum, Register & compensation, const Register & value)
+		{
+		  const Register y = value - compensation;
+		  // lower order bits are lost here with this addition
+		  const Register t = sum + y;
+		  // (t - sum) cancels the higher order part of y and subtracting y recovers the low part of y
+		  compensation = (t - sum) - y;
+		  sum = t;
+		}
+
+	  template <class Register>
+		MULTI_CORE_INLINE void neumaier_add(Register & sum, Register & compensation, const Register & value)
+		{
+		  const Register t = sum + value;
+		  const Register sum_magnitude = sum < 0 ? -sum : sum;
+		  const Register value_magnitude = value < 0 ? -value : value;
+		  compensation += sum_magnitude >= value_magnitude ? (sum - t) + value : (value - t) + sum;
+		  sum = t;
+		}
+
+	  struct kahan_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static T run(const T * x, const std::size_t n_elements, T * remainder)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			const reg * x_lanes = reinterpret_cast<const reg *>(x);
+			reg sum[compensated_registers] = {}, compensation[compensated_registers] = {};
+			std::size_t op{0};
+			for(; op + compensated_registers * width <= n_elements; op += compensated_registers * width)
+			  for(std::size_t i = 0; i < compensated_registers; ++i)
+				kahan_add(sum[i], compensation[i], x_lanes[op / width + i]);
+			for(; op + width <= n_elements; op += width)
+			  kahan_add(sum[0], compensation[0], x_lanes[op / width]);
+			// kahan carries the negated correction
+			reg correction[compensated_registers];
+			for(std::size_t i = 0; i < compensated_registers; ++i)
+			  correction[i] = -compensation[i];
+			return fold<bytes, T>(sum, correction, x, op, n_elements, remainder);
+		  }
+	  };
+
+	  struct neumaier_kernel
+	  {
+		template <std::size_t bytes, class T>
+		  MULTI_CORE_INLINE static T run(const T * x, const std::size_t n_elements, T * remainder)
+		  {
+			using reg = typename lanes<T, bytes>::type;
+			const std::size_t width{lanes<T, bytes>::width};
+			const reg * x_lanes = reinterpret_cast<const reg *>(x);
+			reg sum[compensated_registers] = {}, compensation[compensated_registers] = {};
+			std::size_t op{0};
+			for(; op + compensated_registers * width <= n_elements; op += compensated_registers * width)
+			  for(std::size_t i = 0; i < compensated_registers; ++i)
+				neumaier_add(sum[i], compensation[i], x_lanes[op / width + i]);
+			for(; op + width <= n_elements; op += width)
+			  neumaier_add(sum[0], compensation[0], x_lanes[op / width]);
+			return fold<bytes, T>(sum, compensation, x, op, n_elements, remainder);
+		  }
+	  };
+
+	  // one entry point per instruction set, 16 bytes for sse2, 32 for avx2 and 64 for avx512
+	  template <class Kernel, class... Args>
+		HOST auto run_generic(Args... args) -> decltype(Kernel::template run<16>(args...))
+		{ return Kernel::template run<16>(args...); }
+
+	  template <class Kernel, class... Args>
+		MULTI_CORE_TARGET("sse2") HOST auto run_sse2(Args... args) -> decltype(Kernel::template run<16>(args...))
+		{ return Kernel::template run<16>(args...); }
+
+	  template <class Kernel, class... Args>
+		MULTI_CORE_TARGET("avx2,fma") HOST auto run_avx2(Args... args) -> decltype(Kernel::template run<32>(args...))
+		{ return Kernel::template run<32>(args...); }
+
+	  template <class Kernel, class... Args>
+		MULTI_CORE_TARGET("avx512f,avx2,fma") HOST auto run_avx512(Args... args) -> decltype(Kernel::template run<64>(args...))
+		{ return Kernel::template run<64>(args...); }
+
+	  HOST instruction_set detect_instruction_set()
+	  {
+#if MULTI_CORE_SIMD_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		  return instruction_set::avx512;
+		if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		  return instruction_set::avx2;
+		if(__builtin_cpu_supports("sse2"))
+		  return instruction_set::sse2;
+#endif
+		return instruction_set::generic;
+	  }
+
+	  HOST std::atomic<instruction_set> & active_instruction_set()
+	  {
+		static std::atomic<instruction_set> isa{detect_instruction_set()};
+		return isa;
+	  }
+
+	  HOST instruction_set get_instruction_set()
+	  { return active_instruction_set().load(std::memory_order_relaxed); }
+
+	  HOST instruction_set set_instruction_set(const instruction_set isa)
+	  {
+		const instruction_set supported{detect_instruction_set()};
+		const instruction_set in_effect{static_cast<std::uint32_t>(isa) < static_cast<std::uint32_t>(supported) ? isa : supported};
+		active_instruction_set().store(in_effect, std::memory_order_relaxed);
+		return in_effect;
+	  }
+
+	  HOST const char * to_string(const instruction_set isa)
+	  {
+		if(isa == instruction_set::avx512)
+		  return "avx512";
+		else if(isa == instruction_set::avx2)
+		  return "avx2";
+		else if(isa == instruction_set::sse2)
+		  return "sse2";
+		return "generic";
+	  }
+
+	  template <class Kernel, class... Args>
+		HOST auto dispatch(Args... args) -> decltype(Kernel::template run<16>(args...))
+		{
+		  const instruction_set isa{get_instruction_set()};
+#if MULTI_CORE_SIMD_X86
+		  if(isa == instruction_set::avx512)
+			return run_avx512<Kernel>(args...);
+		  else if(isa == instruction_set::avx2)
+			return run_avx2<Kernel>(args...);
+		  else if(isa == instruction_set::sse2)
+			return run_sse2<Kernel>(args...);
+#endif
+		  return run_generic<Kernel>(args...);
+		}
+
+	  HOST void saxpy(const float a, const float * x, float * y, const std::size_t n_elements)
+	  { dispatch<saxpy_kernel>(a, x, y, n_elements); }
+
+	  HOST void saxpy(const double a, const double * x, double * y, const std::size_t n_elements)
+	  { dispatch<saxpy_kernel>(a, x, y, n_elements); }
+
+	  HOST void copy(const float * x, float * y, const std::size_t n_elements)
+	  { dispatch<copy_kernel>(x, y, n_elements); }
+
+	  HOST void copy(const double * x, double * y, const std::size_t n_elements)
+	  { dispatch<copy_kernel>(x, y, n_elements); }
+
+	  HOST void replace(float * x, const std::size_t n_elements, const float old_value, const float new_value)
+	  { dispatch<replace_kernel>(x, n_elements, old_value, new_value); }
+
+	  HOST void replace(double * x, const std::size_t n_elements, const double old_value, const double new_value)
+	  { dispatch<replace_kernel>(x, n_elements, old_value, new_value); }
+
+	  HOST float accumulate(const float * x, const std::size_t n_elements)
+	  { return dispatch<accumulate_kernel>(x, n_elements); }
+
+	  HOST double accumulate(const double * x, const std::size_t n_elements)
+	  { return dispatch<accumulate_kernel>(x, n_elements); }
+
+	  HOST float inner_product(const float * x, const float * y, const std::size_t n_elements)
+	  { return dispatch<inner_product_kernel>(x, y, n_elements); }
+
+	  HOST double inner_product(const double * x, const double * y, const std::size_t n_elements)
+	  { return dispatch<inner_product_kernel>(x, y, n_elements); }
+
+	  HOST float kahan_sum(const float * x, const std::size_t n_elements)
+	  {
+		float correction;
+		const float sum{dispatch<kahan_kernel>(x, n_elements, &correction)};
+		return sum + correction;
+	  }
+
+	  HOST float kahan_sum(const float * x, const std::size_t n_elements, float & correction)
+	  { return dispatch<kahan_kernel>(x, n_elements, &correction); }
+
+	  HOST double kahan_sum(const double * x, const std::size_t n_elements)
+	  {
+		double correction;
+		const double sum{dispatch<kahan_kernel>(x, n_elements, &correction)};
+		return sum + correction;
+	  }
+
+	  HOST double kahan_sum(const double * x, const std::size_t n_elements, double & correction)
+	  { return dispatch<kahan_kernel>(x, n_elements, &correction); }
+
+	  HOST float neumaier_sum(const float * x, const std::size_t n_elements)
+	  {
+		float correction;
+		const float sum{dispatch<neumaier_kernel>(x, n_elements, &correction)};
+		return sum + correction;
+	  }
+
+	  HOST float neumaier_sum(const float * x, const std::size_t n_elements, float & correction)
+	  { return dispatch<neumaier_kernel>(x, n_elements, &correction); }
+
+	  HOST double neumaier_sum(const double * x, const std::size_t n_elements)
+	  {
+		double correction;
+		const double sum{dispatch<neumaier_kernel>(x, n_elements, &correction)};
+		return sum + correction;
+	  }
+
+	  HOST double neumaier_sum(const double * x, const std::size_t n_elements, double & correction)
+	  { return dispatch<neumaier_kernel>(x, n_elements, &correction); }
+
+	  // philox4x32-10 one block at a time, the 32 x 32 -> 64 bit multiplies are single instructions
+	  HOST void philox_scalar(const std::uint64_t key, const std::uint64_t stream, const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks)
+	  {
+		for(std::size_t block = 0; block < n_blocks; ++block)
+		{
+		  const std::uint64_t counter{first_counter + block};
+		  std::uint32_t x_0{static_cast<std::uint32_t>(counter)}, x_1{static_cast<std::uint32_t>(counter >> 32)};
+		  std::uint32_t x_2{static_cast<std::uint32_t>(stream)}, x_3{static_cast<std::uint32_t>(stream >> 32)};
+		  std::uint32_t key_0{static_cast<std::uint32_t>(key)}, key_1{static_cast<std::uint32_t>(key >> 32)};
+		  for(std::size_t round = 0; round < 10; ++round)
+		  {
+			const std::uint64_t product_0{std::uint64_t{x_0} * 0xD2511F53};
+			const std::uint64_t product_1{std::uint64_t{x_2} * 0xCD9E8D57};
+			x_0 = static_cast<std::uint32_t>(product_1 >> 32) ^ x_1 ^ key_0;
+			x_1 = static_cast<std::uint32_t>(product_1);
+			x_2 = static_cast<std::uint32_t>(product_0 >> 32) ^ x_3 ^ key_1;
+			x_3 = static_cast<std::uint32_t>(product_0);
+			// the weyl sequence that bumps the key between rounds
+			key_0 += 0x9E3779B9;
+			key_1 += 0xBB67AE85;
+		  }
+		  bits[4 * block] = x_0;
+		  bits[4 * block + 1] = x_1;
+		  bits[4 * block + 2] = x_2;
+		  bits[4 * block + 3] = x_3;
+		}
+	  }
+
+#if MULTI_CORE_SIMD_X86
+	  // one counter per 32 bit lane. Vector extensions would widen every product to a full 64 x 64 bit multiply, so the high and low halves
+	  // come from two even lane multiplies, one on the lanes as they are and one on the lanes shifted down. sse2 gains nothing over scalar code
+	  MULTI_CORE_TARGET("avx2") HOST void philox_avx2(const std::uint64_t key, const std::uint64_t stream, const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks)
+	  {
+		const __m256i multiplier_0 = _mm256_set1_epi64x(0xD2511F53), multiplier_1 = _mm256_set1_epi64x(0xCD9E8D57);
+		const __m256i odd_lanes = _mm256_set1_epi64x(std::int64_t(0xffffffff00000000));
+		std::size_t block{0};
+		for(; block + 8 <= n_blocks; block += 8)
+		{
+		  alignas(32) std::uint32_t words[4][8];
+		  for(std::size_t lane = 0; lane < 8; ++lane)
+		  {
+			words[0][lane] = static_cast<std::uint32_t>(first_counter + block + lane);
+			words[1][lane] = static_cast<std::uint32_t>((first_counter + block + lane) >> 32);
+		  }
+		  __m256i x_0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(words[0])), x_1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(words[1]));
+		  __m256i x_2 = _mm256_set1_epi32(static_cast<std::int32_t>(stream)), x_3 = _mm256_set1_epi32(static_cast<std::int32_t>(stream >> 32));
+		  std::uint32_t key_0{static_cast<std::uint32_t>(key)}, key_1{static_cast<std::uint32_t>(key >> 32)};
+		  for(std::size_t round = 0; round < 10; ++round)
+		  {
+			const __m256i even_0 = _mm256_mul_epu32(x_0, multiplier_0), odd_0 = _mm256_mul_epu32(_mm256_srli_epi64(x_0, 32), multiplier_0);
+			const __m256i even_1 = _mm256_mul_epu32(x_2, multiplier_1), odd_1 = _mm256_mul_epu32(_mm256_srli_epi64(x_2, 32), multiplier_1);
+			const __m256i high_0 = _mm256_or_si256(_mm256_srli_epi64(even_0, 32), _mm256_and_si256(odd_0, odd_lanes));
+			const __m256i high_1 = _mm256_or_si256(_mm256_srli_epi64(even_1, 32), _mm256_and_si256(odd_1, odd_lanes));
+			x_0 = _mm256_xor_si256(_mm256_xor_si256(high_1, x_1), _mm256_set1_epi32(static_cast<std::int32_t>(key_0)));
+			x_1 = _mm256_or_si256(_mm256_andnot_si256(odd_lanes, even_1), _mm256_slli_epi64(odd_1, 32));
+			x_2 = _mm256_xor_si256(_mm256_xor_si256(high_0, x_3), _mm256_set1_epi32(static_cast<std::int32_t>(key_1)));
+			x_3 = _mm256_or_si256(_mm256_andnot_si256(odd_lanes, even_0), _mm256_slli_epi64(odd_0, 32));
+			key_0 += 0x9E3779B9;
+			key_1 += 0xBB67AE85;
+		  }
+		  _mm256_store_si256(reinterpret_cast<__m256i *>(words[0]), x_0);
+		  _mm256_store_si256(reinterpret_cast<__m256i *>(words[1]), x_1);
+		  _mm256_store_si256(reinterpret_cast<__m256i *>(words[2]), x_2);
+		  _mm256_store_si256(reinterpret_cast<__m256i *>(words[3]), x_3);
+		  for(std::size_t lane = 0; lane < 8; ++lane)
+			for(std::size_t word = 0; word < 4; ++word)
+			  bits[4 * (block + lane) + word] = words[word][lane];
+		}
+		philox_scalar(key, stream, first_counter + block, bits + 4 * block, n_blocks - block);
+	  }
+
+// gcc 12 reports the deliberately undefined registers inside the avx512 broadcast and shift intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+	  MULTI_CORE_TARGET("avx512f") HOST void philox_avx512(const std::uint64_t key, const std::uint64_t stream, const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks)
+	  {
+		const __m512i multiplier_0 = _mm512_set1_epi64(0xD2511F53), multiplier_1 = _mm512_set1_epi64(0xCD9E8D57);
+		const __m512i odd_lanes = _mm512_set1_epi64(std::int64_t(0xffffffff00000000));
+		std::size_t block{0};
+		for(; block + 16 <= n_blocks; block += 16)
+		{
+		  alignas(64) std::uint32_t words[4][16];
+		  for(std::size_t lane = 0; lane < 16; ++lane)
+		  {
+			words[0][lane] = static_cast<std::uint32_t>(first_counter + block + lane);
+			words[1][lane] = static_cast<std::uint32_t>((first_counter + block + lane) >> 32);
+		  }
+		  __m512i x_0 = _mm512_load_si512(words[0]), x_1 = _mm512_load_si512(words[1]);
+		  __m512i x_2 = _mm512_set1_epi32(static_cast<std::int32_t>(stream)), x_3 = _mm512_set1_epi32(static_cast<std::int32_t>(stream >> 32));
+		  std::uint32_t key_0{static_cast<std::uint32_t>(key)}, key_1{static_cast<std::uint32_t>(key >> 32)};
+		  for(std::size_t round = 0; round < 10; ++round)
+		  {
+			const __m512i even_0 = _mm512_mul_epu32(x_0, multiplier_0), odd_0 = _mm512_mul_epu32(_mm512_srli_epi64(x_0, 32), multiplier_0);
+			const __m512i even_1 = _mm512_mul_epu32(x_2, multiplier_1), odd_1 = _mm512_mul_epu32(_mm512_srli_epi64(x_2, 32), multiplier_1);
+			const __m512i high_0 = _mm512_or_si512(_mm512_srli_epi64(even_0, 32), _mm512_and_si512(odd_0, odd_lanes));
+			const __m512i high_1 = _mm512_or_si512(_mm512_srli_epi64(even_1, 32), _mm512_and_si512(odd_1, odd_lanes));
+			x_0 = _mm512_xor_si512(_mm512_xor_si512(high_1, x_1), _mm512_set1_epi32(static_cast<std::int32_t>(key_0)));
+			x_1 = _mm512_or_si512(_mm512_andnot_si512(odd_lanes, even_1), _mm512_slli_epi64(odd_1, 32));
+			x_2 = _mm512_xor_si512(_mm512_xor_si512(high_0, x_3), _mm512_set1_epi32(static_cast<std::int32_t>(key_1)));
+			x_3 = _mm512_or_si512(_mm512_andnot_si512(odd_lanes, even_0), _mm512_slli_epi64(odd_0, 32));
+			key_0 += 0x9E3779B9;
+			key_1 += 0xBB67AE85;
+		  }
+		  _mm512_store_si512(words[0], x_0);
+		  _mm512_store_si512(words[1], x_1);
+		  _mm512_store_si512(words[2], x_2);
+		  _mm512_store_si512(words[3], x_3);
+		  for(std::size_t lane = 0; lane < 16; ++lane)
+			for(std::size_t word = 0; word < 4; ++word)
+			  bits[4 * (block + lane) + word] = words[word][lane];
+		}
+		philox_scalar(key, stream, first_counter + block, bits + 4 * block, n_blocks - block);
+	  }
+#pragma GCC diagnostic pop
+#endif
+
+	  HOST void philox4x32_blocks(const std::uint64_t key, const std::uint64_t stream, const std::uint64_t first_counter, std::uint32_t * bits, const std::size_t n_blocks)
+	  {
+#if MULTI_CORE_SIMD_X86
+		const instruction_set isa{get_instruction_set()};
+		if(isa == instruction_set::avx512)
+		  return philox_avx512(key, stream, first_counter, bits, n_blocks);
+		else if(isa == instruction_set::avx2)
+		  return philox_avx2(key, stream, first_counter, bits, n_blocks);
+#endif
+		philox_scalar(key, stream, first_counter, bits, n_blocks);
+	  }
+
+	  template <class T, class I>
+		HOST void gather_scalar(const T * x, const I * index, T * y, const std::size_t n_elements)
+		{
+		  for(std::size_t op = 0; op < n_elements; ++op)
+			y[op] = x[index[op]];
+		}
+
+#if MULTI_CORE_SIMD_X86
+// the gather intrinsics start from deliberately undefined registers too
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+	  // eight elements per call, a register of 64 bit indices addresses four
+	  MULTI_CORE_TARGET("avx2") MULTI_CORE_INLINE void gather_avx2_block(const float * x, const std::int32_t * index, float * y)
+	  { _mm256_storeu_ps(y, _mm256_i32gather_ps(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index)), 4)); }
+
+	  MULTI_CORE_TARGET("avx2") MULTI_CORE_INLINE void gather_avx2_block(const double * x, const std::int32_t * index, double * y)
+	  {
+		_mm256_storeu_pd(y, _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i *>(index)), 8));
+		_mm256_storeu_pd(y + 4, _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i *>(index + 4)), 8));
+	  }
+
+	  MULTI_CORE_TARGET("avx2") MULTI_CORE_INLINE void gather_avx2_block(const float * x, const std::int64_t * index, float * y)
+	  {
+		_mm_storeu_ps(y, _mm256_i64gather_ps(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index)), 4));
+		_mm_storeu_ps(y + 4, _mm256_i64gather_ps(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index + 4)), 4));
+	  }
+
+	  MULTI_CORE_TARGET("avx2") MULTI_CORE_INLINE void gather_avx2_block(const double * x, const std::int64_t * index, double * y)
+	  {
+		_mm256_storeu_pd(y, _mm256_i64gather_pd(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index)), 8));
+		_mm256_storeu_pd(y + 4, _mm256_i64gather_pd(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index + 4)), 8));
+	  }
+
+	  template <class T, class I>
+		MULTI_CORE_TARGET("avx2") HOST void gather_avx2(const T * x, const I * index, T * y, const std::size_t n_elements)
+		{
+		  std::size_t op{0};
+		  for(; op + 8 <= n_elements; op += 8)
+			gather_avx2_block(x, index + op, y + op);
+		  gather_scalar(x, index + op, y + op, n_elements - op);
+		}
+
+	  // sixteen elements per call
+	  MULTI_CORE_TARGET("avx512f") MULTI_CORE_INLINE void gather_avx512_block(const float * x, const std::int32_t * index, float * y)
+	  { _mm512_storeu_ps(y, _mm512_i32gather_ps(_mm512_loadu_si512(index), x, 4)); }
+
+	  MULTI_CORE_TARGET("avx512f") MULTI_CORE_INLINE void gather_avx512_block(const double * x, const std::int32_t * index, double * y)
+	  {
+		_mm512_storeu_pd(y, _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(index)), x, 8));
+		_mm512_storeu_pd(y + 8, _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(index + 8)), x, 8));
+	  }
+
+	  MULTI_CORE_TARGET("avx512f") MULTI_CORE_INLINE void gather_avx512_block(const float * x, const std::int64_t * index, float * y)
+	  {
+		_mm256_storeu_ps(y, _mm512_i64gather_ps(_mm512_loadu_si512(index), x, 4));
+		_mm256_storeu_ps(y + 8, _mm512_i64gather_ps(_mm512_loadu_si512(index + 8), x, 4));
+	  }
+
+	  MULTI_CORE_TARGET("avx512f") MULTI_CORE_INLINE void gather_avx512_block(const double * x, const std::int64_t * index, double * y)
+	  {
+		_mm512_storeu_pd(y, _mm512_i64gather_pd(_mm512_loadu_si512(index), x, 8));
+		_mm512_storeu_pd(y + 8, _mm512_i64gather_pd(_mm512_loadu_si512(index + 8), x, 8));
+	  }
+
+	  template <class T, class I>
+		MULTI_CORE_TARGET("avx512f") HOST void gather_avx512(const T * x, const I * index, T * y, const std::size_t n_elements)
+		{
+		  std::size_t op{0};
+		  for(; op + 16 <= n_elements; op += 16)
+			gather_avx512_block(x, index + op, y + op);
+		  gather_scalar(x, index + op, y + op, n_elements - op);
+		}
+#pragma GCC diagnostic pop
+#endif
+
+	  // sse2 has no gather
+	  template <class T, class I>
+		HOST void gather_dispatch(const T * x, const I * index, T * y, const std::size_t n_elements)
+		{
+#if MULTI_CORE_SIMD_X86
+		  const instruction_set isa{get_instruction_set()};
+		  if(isa == instruction_set::avx512)
+			return gather_avx512(x, index, y, n_elements);
+		  else if(isa == instruction_set::avx2)
+			return gather_avx2(x, index, y, n_elements);
+#endif
+		  gather_scalar(x, index, y, n_elements);
+		}
+
+	  HOST void gather(const float * x, const std::int32_t * index, float * y, const std::size_t n_elements)
+	  { gather_dispatch(x, index, y, n_elements); }
+
+	  HOST void gather(const double * x, const std::int32_t * index, double * y, const std::size_t n_elements)
+	  { gather_dispatch(x, index, y, n_elements); }
+
+	  HOST void gather(const float * x, const std::int64_t * index, float * y, const std::size_t n_elements)
+	  { gather_dispatch(x, index, y, n_elements); }
+
+	  HOST void gather(const double * x, const std::int64_t * index, double * y, const std::size_t n_elements)
+	  { gather_dispatch(x, index, y, n_elements); }
+
+	  HOST std::size_t last_level_cache_size()
+	  {
+		long bytes{0};
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+		bytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+		if(bytes <= 0)
+		  bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+		// unknown, assume a typical desktop part
+		return bytes > 0 ? static_cast<std::size_t>(bytes) : std::size_t{8} << 20;
+	  }
+
+	  HOST std::atomic<std::size_t> & streaming_threshold()
+	  {
+		static std::atomic<std::size_t> bytes{last_level_cache_size()};
+		return bytes;
+	  }
+
+	  HOST std::size_t get_streaming_threshold()
+	  { return streaming_threshold().load(std::memory_order_relaxed); }
+
+	  HOST void set_streaming_threshold(const std::size_t bytes)
+	  { streaming_threshold().store(bytes, std::memory_order_relaxed); }
+
+	  HOST bool use_streaming_stores(const std::size_t output_bytes)
+	  { return output_bytes >= get_streaming_threshold(); }
+
+	  // bytes to write through the cache before destination is aligned to alignment
+	  HOST std::size_t unaligned_head(const void * destination, const std::size_t bytes, const std::size_t alignment)
+	  {
+		const std::size_t misalignment{reinterpret_cast<std::uintptr_t>(destination) % alignment};
+		return std::min(bytes, misalignment == 0 ? 0 : alignment - misalignment);
+	  }
+
+#if MULTI_CORE_SIMD_X86
+	  MULTI_CORE_TARGET("sse2") HOST void stream_copy_sse2(const char * source, char * destination, const std::size_t bytes)
+	  {
+		std::size_t op{unaligned_head(destination, bytes, 16)};
+		std::memcpy(destination, source, op);
+		for(; op + 16 <= bytes; op += 16)
+		  _mm_stream_si128(reinterpret_cast<__m128i *>(destination + op), _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + op)));
+		std::memcpy(destination + op, source + op, bytes - op);
+		_mm_sfence();
+	  }
+
+	  MULTI_CORE_TARGET("avx2") HOST void stream_copy_avx2(const char * source, char * destination, const std::size_t bytes)
+	  {
+		std::size_t op{unaligned_head(destination, bytes, 32)};
+		std::memcpy(destination, source, op);
+		for(; op + 32 <= bytes; op += 32)
+		  _mm256_stream_si256(reinterpret_cast<__m256i *>(destination + op), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + op)));
+		std::memcpy(destination + op, source + op, bytes - op);
+		_mm_sfence();
+	  }
+
+	  MULTI_CORE_TARGET("avx512f") HOST void stream_copy_avx512(const char * source, char * destination, const std::size_t bytes)
+	  {
+		std::size_t op{unaligned_head(destination, bytes, 64)};
+		std::memcpy(destination, source, op);
+		for(; op + 64 <= bytes; op += 64)
+		  _mm512_stream_si512(reinterpret_cast<__m512i *>(destination + op), _mm512_loadu_si512(source + op));
+		std::memcpy(destination + op, source + op, bytes - op);
+		_mm_sfence();
+	  }
+
+	  // pattern holds 64 bytes of the repeated value and destination is aligned to value_bytes, so the head is a whole number of values.
+	  // A value wider than the register is stored in pieces, the piece at op starts op % value_bytes bytes into the pattern
+	  MULTI_CORE_TARGET("sse2") HOST void stream_fill_sse2(char * destination, const char * pattern, const std::size_t value_bytes, const std::size_t bytes)
+	  {
+		const std::size_t mask{value_bytes - 1};
+		std::size_t op{unaligned_head(destination, bytes, 16)};
+		std::memcpy(destination, pattern, op);
+		if(value_bytes <= 16)
+		{
+		  const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+		  for(; op + 16 <= bytes; op += 16)
+			_mm_stream_si128(reinterpret_cast<__m128i *>(destination + op), value);
+		}
+		else
+		  for(; op + 16 <= bytes; op += 16)
+			_mm_stream_si128(reinterpret_cast<__m128i *>(destination + op), _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + (op & mask))));
+		std::memcpy(destination + op, pattern + (op & mask), bytes - op);
+		_mm_sfence();
+	  }
+
+	  MULTI_CORE_TARGET("avx2") HOST void stream_fill_avx2(char * destination, const char * pattern, const std::size_t value_bytes, const std::size_t bytes)
+	  {
+		const std::size_t mask{value_bytes - 1};
+		std::size_t op{unaligned_head(destination, bytes, 32)};
+		std::memcpy(destination, pattern, op);
+		if(value_bytes <= 32)
+		{
+		  const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern));
+		  for(; op + 32 <= bytes; op += 32)
+			_mm256_stream_si256(reinterpret_cast<__m256i *>(destination + op), value);
+		}
+		else
+		  for(; op + 32 <= bytes; op += 32)
+			_mm256_stream_si256(reinterpret_cast<__m256i *>(destination + op), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + (op & mask))));
+		std::memcpy(destination + op, pattern + (op & mask), bytes - op);
+		_mm_sfence();
+	  }
+
+	  // every power of two value up to 64 bytes fits the register whole
+	  MULTI_CORE_TARGET("avx512f") HOST void stream_fill_avx512(char * destination, const char * pattern, const std::size_t value_bytes, const std::size_t bytes)
+	  {
+		std::size_t op{unaligned_head(destination, bytes, 64)};
+		std::memcpy(destination, pattern, op);
+		const __m512i value = _mm512_loadu_si512(pattern);
+		for(; op + 64 <= bytes; op += 64)
+		  _mm512_stream_si512(reinterpret_cast<__m512i *>(destination + op), value);
+		std::memcpy(destination + op, pattern + (op & (value_bytes - 1)), bytes - op);
+		_mm_sfence();
+	  }
+#endif
+
+	  HOST void stream_copy_bytes(const void * source, void * destination, const std::size_t bytes)
+	  {
+		const char * from{static_cast<const char *>(source)};
+		char * to{static_cast<char *>(destination)};
+#if MULTI_CORE_SIMD_X86
+		const instruction_set isa{get_instruction_set()};
+		if(isa == instruction_set::avx512)
+		  return stream_copy_avx512(from, to, bytes);
+		else if(isa == instruction_set::avx2)
+		  return stream_copy_avx2(from, to, bytes);
+		else if(isa == instruction_set::sse2)
+		  return stream_copy_sse2(from, to, bytes);
+#endif
+		std::memcpy(to, from, bytes);
+	  }
+
+	  HOST void stream_fill_bytes(void * destination, const void * value, const std::size_t value_bytes, const std::size_t n_values)
+	  {
+		char * to{static_cast<char *>(destination)};
+		const bool power_of_two{value_bytes != 0 && (value_bytes & (value_bytes - 1)) == 0};
+		if(power_of_two && value_bytes <= 64 && reinterpret_cast<std::uintptr_t>(destination) % value_bytes == 0)
+		{
+		  char pattern[64];
+		  for(std::size_t offset = 0; offset < 64; offset += value_bytes)
+			std::memcpy(pattern + offset, value, value_bytes);
+#if MULTI_CORE_SIMD_X86
+		  const instruction_set isa{get_instruction_set()};
+		  if(isa == instruction_set::avx512)
+			return stream_fill_avx512(to, pattern, value_bytes, n_values * value_bytes);
+		  else if(isa == instruction_set::avx2)
+			return stream_fill_avx2(to, pattern, value_bytes, n_values * value_bytes);
+		  else if(isa == instruction_set::sse2)
+			return stream_fill_sse2(to, pattern, value_bytes, n_values * value_bytes);
+#endif
+		}
+		for(std::size_t i = 0; i < n_values; ++i)
+		  std::memcpy(to + i * value_bytes, value, value_bytes);
+	  }
+	}// END NAMESPACE SIMD
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
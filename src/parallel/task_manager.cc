@@ -0,0 +1,36 @@
+#include <multi_core/parallel/task_manager.hh>
+namespace zinhart
+{
+  namespace multi_core
+  {
+	HOST task_manager<heterogeneous>::task_manager(std::uint32_t n_threads)
+	  : private_thread_pool(new thread_pool::scheduler(n_threads)), thread_pool(*private_thread_pool)
+	{ }
+
+	HOST task_manager<heterogeneous>::task_manager(thread_pool::scheduler & scheduler)
+	  : thread_pool(scheduler)
+	{ }
+
+	HOST task_manager<heterogeneous>::~task_manager()
+	{
+	  // destroying a pending future waits on its task, this must happen while the pool is still up
+	  pending_tasks.clear();
+	}
+
+	HOST bool task_manager<heterogeneous>::valid(const slot_handle & handle)const
+	{ return pending_tasks.contains(handle); }
+
+	HOST void task_manager<heterogeneous>::resize(std::uint64_t n_threads)
+	{
+	  if(!private_thread_pool)
+		throw std::logic_error("task_manager: cannot resize a scheduler it shares, resize it through its owner");
+	  thread_pool.resize(n_threads);
+	}
+
+	HOST std::uint64_t task_manager<heterogeneous>::size()const
+	{ return thread_pool.size(); }
+
+	HOST std::uint64_t task_manager<heterogeneous>::pending()const
+	{ return pending_tasks.size(); }
+  }// END NAMESPACE MULTI_CORE
+}// END NAMESPACE ZINHART
@@ -81,11 +81,11 @@ namespace zinhart
 	  }
 	  void resize(std::uint32_t n_threads)
 	  {
-		get_thread_pool().resize(n_threads);
+		get_scheduler().resize(n_threads);
 	  }
 	  const std::uint32_t size()
 	  {
-		return get_thread_pool().size();
+		return get_scheduler().size();
 	  }
 	}// END NAMESPACE THREAD_POOL
   }// END NAMESPACE MULTI_CORE
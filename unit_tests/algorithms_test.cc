@@ -0,0 +1,373 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <random>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <new>
+#include <unistd.h>
+using namespace testing;
+
+TEST(fork_join, covers_every_element_once)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::uint32_t> hits(n_elements, 0);
+  const std::size_t n_chunks{zinhart::multi_core::parallel::default_chunks(n_elements, thread_pool)};
+  std::vector<std::uint32_t> chunk_hits(n_chunks, 0);
+  zinhart::multi_core::parallel::fork_join(n_elements, [&](std::size_t chunk_id, std::size_t start, std::size_t stop)
+	{
+	  ++chunk_hits.at(chunk_id);
+	  for(std::uint32_t i = start; i < stop; ++i)
+		++hits[i];
+	}, thread_pool
+  );
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	ASSERT_EQ(std::uint32_t{1}, hits[i]);
+  for(std::uint32_t i = 0; i < n_chunks; ++i)
+	ASSERT_EQ(std::uint32_t{1}, chunk_hits[i]);
+}
+
+TEST(fork_join, rethrows_exceptions)
+{
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  ASSERT_THROW(
+	zinhart::multi_core::parallel::fork_join(100, 10, [](std::size_t chunk_id, std::size_t start, std::size_t stop)
+	  {
+		if(chunk_id == 7)
+		  throw std::runtime_error("chunk 7");
+	  }, thread_pool
+	), std::runtime_error);
+  // the scheduler is still usable afterwards
+  std::vector<std::uint32_t> x(100, 1);
+  zinhart::multi_core::parallel::for_each(x.begin(), x.end(), [](std::uint32_t & v){ ++v; }, thread_pool);
+  ASSERT_EQ(std::uint32_t{200}, std::accumulate(x.begin(), x.end(), std::uint32_t{0}));
+}
+
+TEST(fork_join, nested_inside_a_task)
+{
+  // every worker is busy running an outer task that itself forks, this must not deadlock
+  zinhart::multi_core::thread_pool::scheduler thread_pool(2);
+  std::vector<zinhart::multi_core::thread_pool::tasks::task_future<std::uint32_t>> results;
+  for(std::uint32_t i = 0; i < 4; ++i)
+	results.push_back(thread_pool.add_task([&thread_pool]()
+	  {
+		std::vector<std::uint32_t> x(1000, 1), y(1000, 0);
+		zinhart::multi_core::parallel::copy(x.begin(), x.end(), y.begin(), thread_pool);
+		return std::accumulate(y.begin(), y.end(), std::uint32_t{0});
+	  }));
+  for(std::uint32_t i = 0; i < results.size(); ++i)
+	ASSERT_EQ(std::uint32_t{1000}, results[i].get());
+}
+
+TEST(parallel_algorithms, for_each)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::int32_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<std::int32_t> x_parallel(n_elements), x_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x_serial[i] = x_parallel[i] = int_dist(mt);
+  auto f = [](std::int32_t & v){ v = v * 3 - 1; };
+  zinhart::multi_core::parallel::for_each(x_parallel.begin(), x_parallel.end(), f);
+  std::for_each(x_serial.begin(), x_serial.end(), f);
+  ASSERT_EQ(x_serial, x_parallel);
+}
+
+TEST(parallel_algorithms, transform)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_real_distribution<double> real_dist(-1000.0, 1000.0);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<double> x(n_elements), y(n_elements), out_parallel(n_elements), out_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	x[i] = real_dist(mt);
+	y[i] = real_dist(mt);
+  }
+  auto unary_op = [](double v){ return v * v; };
+  auto binary_op = [](double a, double b){ return a - b; };
+  ASSERT_TRUE(out_parallel.end() == zinhart::multi_core::parallel::transform(x.begin(), x.end(), out_parallel.begin(), unary_op));
+  std::transform(x.begin(), x.end(), out_serial.begin(), unary_op);
+  ASSERT_EQ(out_serial, out_parallel);
+  ASSERT_TRUE(out_parallel.end() == zinhart::multi_core::parallel::transform(x.begin(), x.end(), y.begin(), out_parallel.begin(), binary_op));
+  std::transform(x.begin(), x.end(), y.begin(), out_serial.begin(), binary_op);
+  ASSERT_EQ(out_serial, out_parallel);
+}
+
+TEST(parallel_algorithms, copy)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_real_distribution<float> real_dist(-1000.0, 1000.0);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<float> x(n_elements), y(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = real_dist(mt);
+  ASSERT_TRUE(y.end() == zinhart::multi_core::parallel::copy(x.begin(), x.end(), y.begin()));
+  ASSERT_EQ(x, y);
+  // plain pointers work too
+  float * z = new float[n_elements];
+  ASSERT_EQ(z + n_elements, zinhart::multi_core::parallel::copy(x.data(), x.data() + n_elements, z));
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	ASSERT_EQ(x[i], z[i]);
+  delete [] z;
+}
+
+TEST(parallel_algorithms, saxpy)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_real_distribution<float> real_dist(-1000.0, 1000.0);
+  const std::uint32_t n_elements{size_dist(mt)};
+  const float alpha{real_dist(mt)};
+  std::vector<float> x(n_elements), y_parallel(n_elements), y_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	x[i] = real_dist(mt);
+	y_serial[i] = y_parallel[i] = real_dist(mt);
+  }
+  zinhart::multi_core::parallel::saxpy(alpha, x.begin(), x.end(), y_parallel.begin());
+  if(n_elements > 0)
+	zinhart::multi_core::async::saxpy(alpha, x.data(), y_serial.data(), n_elements);
+  ASSERT_EQ(y_serial, y_parallel);
+}
+
+TEST(parallel_algorithms, copy_if_compacts)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  std::uniform_int_distribution<std::int32_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::int32_t> x(n_elements), out_parallel(n_elements, 0), out_serial(n_elements, 0);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = int_dist(mt);
+  std::atomic<std::uint32_t> calls{0};
+  auto is_even = [&calls](std::int32_t v){ ++calls; return v % 2 == 0; };
+  auto parallel_end = zinhart::multi_core::parallel::copy_if(x.begin(), x.end(), out_parallel.begin(), is_even, thread_pool);
+  // the predicate runs once per element
+  ASSERT_EQ(n_elements, calls.load());
+  auto serial_end = std::copy_if(x.begin(), x.end(), out_serial.begin(), is_even);
+  ASSERT_EQ(serial_end - out_serial.begin(), parallel_end - out_parallel.begin());
+  ASSERT_EQ(out_serial, out_parallel);
+
+  parallel_end = zinhart::multi_core::parallel::remove_copy_if(x.begin(), x.end(), out_parallel.begin(), is_even, thread_pool);
+  serial_end = std::remove_copy_if(x.begin(), x.end(), out_serial.begin(), is_even);
+  ASSERT_EQ(serial_end - out_serial.begin(), parallel_end - out_parallel.begin());
+  ASSERT_TRUE(std::equal(out_serial.begin(), serial_end, out_parallel.begin()));
+}
+
+TEST(parallel_algorithms, partition_copy)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::int32_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<std::int32_t> x(n_elements), true_parallel(n_elements), false_parallel(n_elements), true_serial(n_elements), false_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = int_dist(mt);
+  auto is_negative = [](std::int32_t v){ return v < 0; };
+  auto parallel_ends = zinhart::multi_core::parallel::partition_copy(x.begin(), x.end(), true_parallel.begin(), false_parallel.begin(), is_negative);
+  auto serial_ends = std::partition_copy(x.begin(), x.end(), true_serial.begin(), false_serial.begin(), is_negative);
+  ASSERT_EQ(serial_ends.first - true_serial.begin(), parallel_ends.first - true_parallel.begin());
+  ASSERT_EQ(serial_ends.second - false_serial.begin(), parallel_ends.second - false_parallel.begin());
+  ASSERT_TRUE(std::equal(true_serial.begin(), serial_ends.first, true_parallel.begin()));
+  ASSERT_TRUE(std::equal(false_serial.begin(), serial_ends.second, false_parallel.begin()));
+}
+
+TEST(parallel_algorithms, gather_scatter_and_permute)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_real_distribution<double> real_dist(-1000.0, 1000.0);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<double> x(n_elements), y(n_elements), z(n_elements);
+  for(double & value : x)
+	value = real_dist(mt);
+  std::vector<std::int32_t> permutation(n_elements);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), mt);
+
+  ASSERT_EQ(y.data() + n_elements, zinhart::multi_core::parallel::gather(permutation.data(), permutation.data() + n_elements, x.data(), y.data(), thread_pool));
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	ASSERT_EQ(x[permutation[i]], y[i]);
+  // scattering back through the same permutation undoes the gather
+  zinhart::multi_core::parallel::scatter(y.begin(), y.end(), permutation.begin(), z.begin(), thread_pool);
+  ASSERT_EQ(x, z);
+  zinhart::multi_core::parallel::permute(z.begin(), z.end(), permutation.begin(), thread_pool);
+  ASSERT_EQ(y, z);
+
+  // repeated indices keep the highest position
+  std::uniform_int_distribution<std::uint32_t> index_dist(0, n_elements / 8);
+  std::vector<std::size_t> repeated(n_elements);
+  for(std::size_t & index : repeated)
+	index = index_dist(mt);
+  std::vector<double> serial(n_elements / 8 + 1, 0.0), resolved(n_elements / 8 + 1, 0.0);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	serial[repeated[i]] = x[i];
+  zinhart::multi_core::parallel::scatter_last(x.begin(), x.end(), repeated.begin(), resolved.begin(), resolved.end(), thread_pool);
+  ASSERT_EQ(serial, resolved);
+}
+
+TEST(fork_join, chunk_plans_cover_the_range_in_order)
+{
+  using zinhart::multi_core::parallel::schedule;
+  using zinhart::multi_core::parallel::schedule_kind;
+  using zinhart::multi_core::parallel::chunk_plan;
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> grain_dist(1, 1000);
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  const std::uint32_t n_elements{size_dist(mt)}, grain{grain_dist(mt)}, n_participants{thread_dist(mt)};
+  for(schedule policy : {schedule(schedule_kind::static_chunks), schedule(schedule_kind::dynamic_chunks, grain), schedule(schedule_kind::guided_chunks, grain)})
+  {
+	chunk_plan plan(policy, n_elements, n_participants);
+	std::size_t expected_start{0}, start{0}, stop{0};
+	for(std::size_t chunk_id = 0; chunk_id < plan.size(); ++chunk_id)
+	{
+	  plan.range(chunk_id, start, stop);
+	  ASSERT_EQ(expected_start, start);
+	  ASSERT_LT(start, stop);
+	  // only the last dynamic or guided chunk may be smaller than the grain
+	  if(policy.get_kind() != schedule_kind::static_chunks && chunk_id + 1 < plan.size())
+	  {
+		ASSERT_GE(stop - start, grain);
+	  }
+	  expected_start = stop;
+	}
+	ASSERT_EQ(n_elements, expected_start);
+  }
+  ASSERT_EQ(std::size_t{std::min(n_elements, n_participants)}, chunk_plan(schedule(), n_elements, n_participants).size());
+  ASSERT_EQ(std::size_t{(n_elements + grain - 1) / grain}, chunk_plan(schedule(schedule_kind::dynamic_chunks, grain), n_elements, n_participants).size());
+  // guided chunks shrink
+  chunk_plan guided(schedule(schedule_kind::guided_chunks), 1 << 20, 4);
+  std::size_t first_start{0}, first_stop{0}, last_start{0}, last_stop{0};
+  guided.range(0, first_start, first_stop);
+  guided.range(guided.size() - 1, last_start, last_stop);
+  ASSERT_EQ(std::size_t{1 << 17}, first_stop - first_start);
+  ASSERT_LT(last_stop - last_start, first_stop - first_start);
+}
+
+TEST(parallel_algorithms, schedules_balance_uneven_work)
+{
+  using zinhart::multi_core::parallel::schedule;
+  using zinhart::multi_core::parallel::schedule_kind;
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  const std::uint32_t n_elements{5000};
+  std::vector<std::uint64_t> x(n_elements);
+  for(schedule policy : {schedule(schedule_kind::static_chunks), schedule(schedule_kind::dynamic_chunks, 16), schedule(schedule_kind::guided_chunks, 4)})
+  {
+	std::vector<std::atomic<std::uint32_t>> hits(n_elements);
+	for(std::atomic<std::uint32_t> & h : hits)
+	  h = 0;
+	std::iota(x.begin(), x.end(), 0);
+	// the cost of an element grows with its index
+	zinhart::multi_core::parallel::for_each(hits.begin(), hits.end(), [](std::atomic<std::uint32_t> & h){ ++h; }, policy, thread_pool);
+	zinhart::multi_core::parallel::transform(x.begin(), x.end(), x.begin(), [](std::uint64_t v)
+	  {
+		std::uint64_t sum{0};
+		for(std::uint64_t i = 0; i < v; ++i)
+		  sum += i;
+		return sum;
+	  }, policy, thread_pool);
+	for(std::uint32_t i = 0; i < n_elements; ++i)
+	{
+	  ASSERT_EQ(std::uint32_t{1}, hits[i].load());
+	  ASSERT_EQ(std::uint64_t{i} * (i > 0 ? i - 1 : 0) / 2, x[i]);
+	}
+	std::vector<std::uint64_t> evens(n_elements), evens_serial(n_elements);
+	auto is_even = [](std::uint64_t v){ return v % 2 == 0; };
+	auto end = zinhart::multi_core::parallel::copy_if(x.begin(), x.end(), evens.begin(), is_even, policy, thread_pool);
+	auto serial_end = std::copy_if(x.begin(), x.end(), evens_serial.begin(), is_even);
+	ASSERT_EQ(serial_end - evens_serial.begin(), end - evens.begin());
+	ASSERT_EQ(evens_serial, evens);
+  }
+}
+
+TEST(fork_join, auto_chunks_run_small_inputs_inline)
+{
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  const std::uint32_t min_bytes{zinhart::multi_core::parallel::min_bytes_per_task};
+  ASSERT_EQ(std::size_t{0}, zinhart::multi_core::parallel::auto_chunks(0, sizeof(double), thread_pool));
+  ASSERT_EQ(std::size_t{1}, zinhart::multi_core::parallel::auto_chunks(1, sizeof(double), thread_pool));
+  ASSERT_EQ(std::size_t{1}, zinhart::multi_core::parallel::auto_chunks(min_bytes / sizeof(double), sizeof(double), thread_pool));
+  ASSERT_EQ(std::size_t{3}, zinhart::multi_core::parallel::auto_chunks(3 * min_bytes / sizeof(double), sizeof(double), thread_pool));
+  ASSERT_EQ(std::size_t{5}, zinhart::multi_core::parallel::auto_chunks(100 * min_bytes, 1, thread_pool));
+
+  // a small for_each never leaves the calling thread
+  const std::thread::id caller{std::this_thread::get_id()};
+  std::vector<std::thread::id> ran_on(100);
+  std::vector<std::uint32_t> index(100);
+  std::iota(index.begin(), index.end(), 0);
+  zinhart::multi_core::parallel::for_each(index.begin(), index.end(), [&](std::uint32_t i){ ran_on[i] = std::this_thread::get_id(); }, thread_pool);
+  for(const std::thread::id & id : ran_on)
+	ASSERT_EQ(caller, id);
+}
+
+TEST(fork_join, chunk_plans_past_32_bits)
+{
+  using zinhart::multi_core::parallel::schedule;
+  using zinhart::multi_core::parallel::schedule_kind;
+  using zinhart::multi_core::parallel::chunk_plan;
+  const std::size_t n_elements{(std::size_t{1} << 34) + 3};
+  for(schedule policy : {schedule(schedule_kind::static_chunks), schedule(schedule_kind::dynamic_chunks, std::size_t{1} << 30), schedule(schedule_kind::guided_chunks, std::size_t{1} << 28)})
+  {
+	chunk_plan plan(policy, n_elements, 4);
+	std::size_t expected_start{0}, start{0}, stop{0};
+	for(std::size_t chunk_id = 0; chunk_id < plan.size(); ++chunk_id)
+	{
+	  plan.range(chunk_id, start, stop);
+	  ASSERT_EQ(expected_start, start);
+	  ASSERT_LT(start, stop);
+	  expected_start = stop;
+	}
+	ASSERT_EQ(n_elements, expected_start);
+  }
+}
+
+TEST(parallel_algorithms, arrays_past_32_bits)
+{
+  const std::size_t n_elements{(std::size_t{1} << 32) + 1024};
+  // needs a little over 4 GiB, leave headroom for everything else
+  const std::size_t available{static_cast<std::size_t>(sysconf(_SC_AVPHYS_PAGES)) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE))};
+  if(available < n_elements + (n_elements >> 2))
+	GTEST_SKIP() << "not enough free memory for a " << n_elements << " byte array";
+  std::unique_ptr<std::uint8_t[]> x;
+  try
+  {
+	x.reset(new std::uint8_t[n_elements]);
+  }
+  catch(const std::bad_alloc &)
+  {
+	GTEST_SKIP() << "could not allocate a " << n_elements << " byte array";
+  }
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  zinhart::multi_core::parallel::for_each(x.get(), x.get() + n_elements, [](std::uint8_t & v){ v = 1; }, thread_pool);
+  // the tail past 2^32 must have been written too
+  for(std::size_t i = n_elements - 2048; i < n_elements; ++i)
+	ASSERT_EQ(1, x[i]);
+  ASSERT_EQ(std::uint64_t{n_elements}, zinhart::multi_core::parallel::transform_reduce(x.get(), x.get() + n_elements, std::uint64_t{0}, std::plus<std::uint64_t>(), [](std::uint8_t v){ return std::uint64_t{v}; }, thread_pool));
+}
@@ -1,4 +1,5 @@
 #include <multi_core/multi_core.hh>
+#include <multi_core/parallel/vectorized/vectorized.hh>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <iostream>
@@ -145,6 +146,51 @@ TEST(cpu_test_parallel, copy_if)
   delete [] x_serial;
   delete [] y_serial;
 }
+
+TEST(cpu_test, map_with_fewer_elements_than_threads)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(2, 64);
+  const std::uint32_t n_threads{thread_dist(mt)};
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, n_threads - 1);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::size_t start{0}, stop{0}, covered{0};
+  for(std::uint32_t thread_id = 0; thread_id < n_threads; ++thread_id)
+  {
+	zinhart::multi_core::map(thread_id, n_threads, n_elements, start, stop);
+	ASSERT_LE(start, stop);
+	ASSERT_LE(stop, n_elements);
+	ASSERT_EQ(covered, start);
+	covered = stop;
+  }
+  ASSERT_EQ(n_elements, covered);
+
+  // the async kernels skip empty ranges
+  std::vector<double> x(n_elements, 1.5);
+  double sum{0};
+  for(std::uint32_t thread_id = 0; thread_id < n_threads; ++thread_id)
+	zinhart::multi_core::vectorized::kahan_sum(x.data(), sum, thread_id, n_elements, n_threads);
+  ASSERT_EQ(1.5 * n_elements, sum);
+}
+
+TEST(cpu_test, helpers_past_32_bits)
+{
+  const std::size_t n_elements{(std::size_t{1} << 33) + 7};
+  const std::uint32_t n_threads{3};
+  std::size_t start{0}, stop{0}, covered{0};
+  for(std::uint32_t thread_id = 0; thread_id < n_threads; ++thread_id)
+  {
+	zinhart::multi_core::map(thread_id, n_threads, n_elements, start, stop);
+	ASSERT_EQ(covered, start);
+	covered = stop;
+  }
+  ASSERT_EQ(n_elements, covered);
+  ASSERT_EQ((std::size_t{1} << 32) * 3 + 5, zinhart::multi_core::idx2r(3, 5, std::size_t{1} << 32));
+  ASSERT_EQ((std::size_t{1} << 32) * 3 + 5, zinhart::multi_core::idx2c(5, 3, std::size_t{1} << 32));
+  ASSERT_EQ(std::uint64_t{1} << 33, zinhart::multi_core::next_pow2((std::uint64_t{1} << 32) + 1));
+}
+
 /*
 TEST(cpu_test_parallel, replace)
 {
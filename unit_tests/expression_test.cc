@@ -0,0 +1,95 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <cmath>
+using namespace testing;
+using zinhart::multi_core::parallel::lazy;
+using zinhart::multi_core::parallel::map;
+using zinhart::multi_core::parallel::store;
+using zinhart::multi_core::parallel::fold;
+using zinhart::multi_core::parallel::sum;
+
+TEST(expression, nodes_are_lazy_and_elementwise)
+{
+  std::vector<double> x{1, 2, 3, 4}, y{10, 20, 30, 40, 50};
+  std::uint32_t calls{0};
+  auto e = (2.0 * lazy(x.begin(), x.end()) + lazy(y.begin(), y.end())) | map([&calls](double v){ ++calls; return v / 2; });
+  // nothing runs until the expression is evaluated, the shorter range sets the size
+  ASSERT_EQ(std::uint32_t{0}, calls);
+  ASSERT_EQ(std::size_t{4}, e.size());
+  ASSERT_EQ(6.0, e[0]);
+  ASSERT_EQ(std::uint32_t{1}, calls);
+  ASSERT_EQ(-2.0, (-lazy(x.begin(), x.end()) / 2.0 - 0.5)[2]);
+  ASSERT_EQ(2.0, (12.0 / lazy(x.begin(), x.end()) - lazy(x.begin(), x.end()) * 2.5)[3] + 9.0);
+  // the result type follows the operators
+  auto mixed = lazy(x.begin(), x.end()) * 2;
+  static_assert(std::is_same<double, decltype(mixed)::value_type>::value, "double * int is a double");
+  auto lengths = lazy(x.begin(), x.end()) | map([](double v){ return std::to_string(int(v)); }) | map([](const std::string & s){ return s.size(); });
+  static_assert(std::is_same<std::size_t, decltype(lengths)::value_type>::value, "map changes the value type");
+  ASSERT_EQ(std::size_t{1}, lengths[0]);
+}
+
+TEST(expression, fused_passes_match_separate_passes)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 200000);
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  std::uniform_int_distribution<std::int64_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::int64_t> x(n_elements), y(n_elements), z(n_elements), expected(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	x[i] = int_dist(mt);
+	y[i] = int_dist(mt);
+  }
+  const std::int64_t a{3};
+  auto square = [](std::int64_t v){ return v * v; };
+  // saxpy, transform, accumulate as three passes
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	expected[i] = square(a * x[i] + y[i]);
+  const std::int64_t expected_sum{std::accumulate(expected.begin(), expected.end(), std::int64_t{5})};
+  auto e = (a * lazy(x.begin(), x.end()) + lazy(y.begin(), y.end())) | map(square);
+  // integers make every order of addition exact
+  ASSERT_EQ(expected_sum, e | sum(std::int64_t{5}, thread_pool));
+  ASSERT_EQ(expected_sum - 5, e | sum(thread_pool));
+  ASSERT_EQ(expected_sum, sum(e, std::int64_t{5}, thread_pool));
+  ASSERT_EQ(expected_sum, e | fold(std::int64_t{5}, std::plus<std::int64_t>(), thread_pool));
+  ASSERT_EQ(z.begin() + n_elements, e | store(z.begin(), thread_pool));
+  ASSERT_EQ(expected, z);
+  // in place, y = a * x + y
+  (a * lazy(x.begin(), x.end()) + lazy(y.begin(), y.end())) | store(y.begin(), thread_pool);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	ASSERT_EQ(square(y[i]), expected[i]);
+  // fold keeps the elements in order for non commutative operations
+  std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+  ASSERT_EQ(std::string("_ABCDEFG"), lazy(words.begin(), words.end()) | map([](const std::string & s){ return std::string(1, char(std::toupper(s[0]))); })
+	                                                              | fold(std::string("_"), std::plus<std::string>(), thread_pool));
+}
+
+TEST(expression, floating_point_sums_are_accurate)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, 100000);
+  std::uniform_real_distribution<double> real_dist(0.0, 1.0);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<double> x(n_elements), y(n_elements);
+  long double exact{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	x[i] = real_dist(mt);
+	y[i] = real_dist(mt);
+	exact += static_cast<long double>(x[i]) * y[i];
+  }
+  const double dot{lazy(x.begin(), x.end()) * lazy(y.data(), y.data() + n_elements) | sum()};
+  ASSERT_NEAR(exact, dot, n_elements * std::numeric_limits<double>::epsilon() * exact);
+  ASSERT_EQ(0.0, lazy(x.begin(), x.begin()) | sum());
+}
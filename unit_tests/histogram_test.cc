@@ -0,0 +1,103 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+using namespace testing;
+using zinhart::multi_core::parallel::bincount;
+using zinhart::multi_core::parallel::histogram;
+using zinhart::multi_core::parallel::private_histogram_bytes;
+
+namespace
+{
+  std::vector<std::size_t> serial_bincount(const std::vector<std::int32_t> & values, const std::size_t n_bins)
+  {
+	std::vector<std::size_t> counts(n_bins, 0);
+	for(std::int32_t value : values)
+	  if(value >= 0 && static_cast<std::size_t>(value) < n_bins)
+		++counts[value];
+	return counts;
+  }
+}
+
+TEST(histogram, bincount_matches_serial_counts_with_private_and_shared_bins)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  // the first fits private copies, the second forces the shared atomic bins
+  for(const std::size_t n_bins : {std::size_t{1}, std::size_t{100}, private_histogram_bytes / sizeof(std::size_t) + 1})
+  {
+	std::uniform_int_distribution<std::int32_t> dist(-10, static_cast<std::int32_t>(n_bins) + 10);
+	std::vector<std::int32_t> values(1 << 20);
+	for(std::int32_t & value : values)
+	  value = dist(mt);
+	const std::vector<std::size_t> expected{serial_bincount(values, n_bins)};
+	std::vector<std::size_t> counts(n_bins, 7);
+	const std::size_t counted{bincount(values.begin(), values.end(), counts.data(), n_bins, thread_pool)};
+	ASSERT_EQ(expected, counts);
+	std::size_t total{0};
+	for(std::size_t count : expected)
+	  total += count;
+	ASSERT_EQ(total, counted);
+  }
+  std::vector<std::int32_t> empty;
+  std::vector<std::size_t> counts(4, 7);
+  ASSERT_EQ(0u, bincount(empty.begin(), empty.end(), counts.data(), counts.size()));
+  ASSERT_EQ(std::vector<std::size_t>(4, 0), counts);
+}
+
+TEST(histogram, uniform_bins_handle_edges_and_nan)
+{
+  std::vector<double> values{0.0, 0.24, 0.25, 0.5, 0.99, 1.0, -0.01, 1.01, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()};
+  std::vector<std::size_t> counts(4);
+  ASSERT_EQ(6u, histogram(values.begin(), values.end(), 0.0, 1.0, counts.data(), counts.size()));
+  ASSERT_EQ((std::vector<std::size_t>{2, 1, 1, 2}), counts);
+
+  // integer bounds split the range as real numbers do, for integer and floating point elements
+  std::vector<std::int32_t> integers(100);
+  std::iota(integers.begin(), integers.end(), 0);
+  std::vector<std::size_t> tens(10);
+  ASSERT_EQ(100u, histogram(integers.begin(), integers.end(), 0, 100, tens.data(), tens.size()));
+  ASSERT_EQ(std::vector<std::size_t>(10, 10), tens);
+  std::vector<double> halves{0.5, 1.5, 2.5, 3.5, 3.75, 4.0};
+  ASSERT_EQ(6u, histogram(halves.begin(), halves.end(), 0, 4, counts.data(), counts.size()));
+  ASSERT_EQ((std::vector<std::size_t>{1, 1, 1, 3}), counts);
+  // the full range of a signed type does not overflow
+  std::vector<std::int32_t> extremes{std::numeric_limits<std::int32_t>::min(), -1, 0, std::numeric_limits<std::int32_t>::max()};
+  std::vector<std::size_t> halves_counts(2);
+  ASSERT_EQ(4u, histogram(extremes.begin(), extremes.end(), std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max(), halves_counts.data(), 2));
+  ASSERT_EQ((std::vector<std::size_t>{2, 2}), halves_counts);
+  // an empty or reversed range has no bins
+  ASSERT_THROW(histogram(values.begin(), values.end(), 1.0, 1.0, counts.data(), counts.size()), std::invalid_argument);
+  ASSERT_THROW(histogram(integers.begin(), integers.end(), 5, 2, counts.data(), counts.size()), std::invalid_argument);
+  ASSERT_THROW(histogram(values.begin(), values.end(), 0.0, std::numeric_limits<double>::quiet_NaN(), counts.data(), counts.size()), std::invalid_argument);
+
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::normal_distribution<float> dist(0.0f, 1.0f);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  std::vector<float> normals(1 << 20);
+  for(float & value : normals)
+	value = dist(mt);
+  for(const std::size_t n_bins : {std::size_t{64}, private_histogram_bytes / sizeof(std::size_t) + 1})
+  {
+	const float lower{-2.0f}, upper{2.0f};
+	// bins of float elements are computed in double
+	const double scale{static_cast<double>(n_bins) / (double(upper) - double(lower))};
+	std::vector<std::size_t> expected(n_bins, 0);
+	std::size_t in_range{0};
+	for(float value : normals)
+	  if(value >= lower && value <= upper)
+	  {
+		++expected[std::min(static_cast<std::size_t>((double(value) - double(lower)) * scale), n_bins - 1)];
+		++in_range;
+	  }
+	std::vector<std::size_t> parallel_counts(n_bins);
+	ASSERT_EQ(in_range, histogram(normals.begin(), normals.end(), lower, upper, parallel_counts.data(), n_bins, thread_pool));
+	ASSERT_EQ(expected, parallel_counts);
+  }
+}
@@ -0,0 +1,97 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+using namespace testing;
+
+TEST(parallel_radix_sort, key_encodings_preserve_order)
+{
+  using zinhart::multi_core::parallel::radix_traits;
+  std::vector<std::int32_t> ints{std::numeric_limits<std::int32_t>::min(), -5, -1, 0, 1, 7, std::numeric_limits<std::int32_t>::max()};
+  for(std::uint32_t i = 1; i < ints.size(); ++i)
+	ASSERT_LT(radix_traits<std::int32_t>::encode(ints[i - 1]), radix_traits<std::int32_t>::encode(ints[i]));
+  std::vector<double> reals{-std::numeric_limits<double>::infinity(), -1.0e300, -2.5, -std::numeric_limits<double>::denorm_min(), -0.0, 0.0,
+	                        std::numeric_limits<double>::denorm_min(), 1.0, 3.5e200, std::numeric_limits<double>::infinity()};
+  for(std::uint32_t i = 1; i < reals.size(); ++i)
+	ASSERT_LT(radix_traits<double>::encode(reals[i - 1]), radix_traits<double>::encode(reals[i]));
+}
+
+TEST(parallel_radix_sort, unsigned_signed_and_float_keys)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 4 * std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+
+  std::uniform_int_distribution<std::uint64_t> u64_dist;
+  std::vector<std::uint64_t> u(n_elements);
+  for(std::uint64_t & v : u)
+	v = u64_dist(mt);
+  std::vector<std::uint64_t> u_serial(u);
+  zinhart::multi_core::parallel::radix_sort(u.data(), n_elements, thread_pool);
+  std::sort(u_serial.begin(), u_serial.end());
+  ASSERT_EQ(u_serial, u);
+
+  std::uniform_int_distribution<std::int16_t> i16_dist(std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max());
+  std::vector<std::int16_t> s(n_elements), buffer(n_elements);
+  for(std::int16_t & v : s)
+	v = i16_dist(mt);
+  std::vector<std::int16_t> s_serial(s);
+  zinhart::multi_core::parallel::radix_sort(s.data(), n_elements, buffer.data(), thread_pool);
+  std::sort(s_serial.begin(), s_serial.end());
+  ASSERT_EQ(s_serial, s);
+
+  std::uniform_real_distribution<float> real_dist(-1.0e6f, 1.0e6f);
+  std::vector<float> f(n_elements);
+  for(float & v : f)
+	v = real_dist(mt);
+  std::vector<float> f_serial(f);
+  zinhart::multi_core::parallel::radix_sort(f.data(), n_elements, thread_pool);
+  std::sort(f_serial.begin(), f_serial.end());
+  ASSERT_EQ(f_serial, f);
+}
+
+TEST(parallel_radix_sort, skipped_passes)
+{
+  // only the low byte differs, so 3 of 4 passes are skipped and the result has to be copied back from the buffer
+  std::vector<std::uint32_t> x(1000);
+  for(std::uint32_t i = 0; i < x.size(); ++i)
+	x[i] = 0xAB000000u | ((i * 37) % 256);
+  std::vector<std::uint32_t> x_serial(x);
+  zinhart::multi_core::parallel::radix_sort(x.data(), x.size());
+  std::sort(x_serial.begin(), x_serial.end());
+  ASSERT_EQ(x_serial, x);
+}
+
+TEST(parallel_radix_sort, sort_by_key_and_argsort_are_stable)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 4 * std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::int32_t> key_dist(-50, 50);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<std::int32_t> keys(n_elements);
+  std::vector<std::size_t> values(n_elements), indices(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	keys[i] = key_dist(mt);
+	values[i] = i;
+  }
+  std::vector<std::size_t> expected(n_elements);
+  std::iota(expected.begin(), expected.end(), 0);
+  std::stable_sort(expected.begin(), expected.end(), [&keys](std::size_t a, std::size_t b){ return keys[a] < keys[b]; });
+
+  const std::vector<std::int32_t> original_keys(keys);
+  zinhart::multi_core::parallel::argsort(keys.data(), n_elements, indices.data());
+  ASSERT_EQ(original_keys, keys);
+  ASSERT_EQ(expected, indices);
+
+  zinhart::multi_core::parallel::sort_by_key(keys.data(), values.data(), n_elements);
+  ASSERT_EQ(expected, values);
+  ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+}
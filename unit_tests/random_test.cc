@@ -0,0 +1,139 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+using namespace testing;
+using zinhart::multi_core::simd::instruction_set;
+
+TEST(random, philox_matches_the_known_answers)
+{
+  // the known answer tests published with random123, counter words are low first and the key is (key_0, key_1)
+  const std::uint32_t expected[3][4] = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+	                                    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+	                                    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+  const zinhart::multi_core::random::philox4x32 engines[3] = {zinhart::multi_core::random::philox4x32(0, 0),
+	                                                          zinhart::multi_core::random::philox4x32(0xffffffffffffffff, 0xffffffffffffffff),
+	                                                          zinhart::multi_core::random::philox4x32(0x299f31d0a4093822, 0x0370734413198a2e)};
+  const std::uint64_t counters[3] = {0, 0xffffffffffffffff, 0x85a308d3243f6a88};
+  for(instruction_set isa : {instruction_set::generic, instruction_set::sse2, instruction_set::avx2, instruction_set::avx512})
+  {
+	const instruction_set in_effect{zinhart::multi_core::simd::set_instruction_set(isa)};
+	for(std::uint32_t i = 0; i < 3; ++i)
+	{
+	  std::uint32_t bits[4];
+	  engines[i].blocks(counters[i], bits, 1);
+	  for(std::uint32_t word = 0; word < 4; ++word)
+		ASSERT_EQ(expected[i][word], bits[word]) << zinhart::multi_core::simd::to_string(in_effect);
+	}
+	// a long run is the same for every instruction set and every starting counter
+	std::vector<std::uint32_t> run(4 * 1001), shifted(4 * 1000);
+	engines[2].blocks(17, run.data(), 1001);
+	engines[2].blocks(18, shifted.data(), 1000);
+	ASSERT_TRUE(std::equal(shifted.begin(), shifted.end(), run.begin() + 4));
+  }
+  zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+}
+
+TEST(random, philox_is_a_bit_generator)
+{
+  zinhart::multi_core::random::philox4x32 engine(42, 7), skipped(42, 7);
+  std::vector<std::uint32_t> bits(4 * 10);
+  engine.blocks(0, bits.data(), 10);
+  for(std::uint32_t i = 0; i < bits.size(); ++i)
+	ASSERT_EQ(bits[i], engine());
+  skipped.discard(bits.size());
+  ASSERT_EQ(engine, skipped);
+  ASSERT_EQ(engine(), skipped());
+  // streams and seeds are independent
+  ASSERT_NE(zinhart::multi_core::random::philox4x32(42, 7)(), zinhart::multi_core::random::philox4x32(42, 8)());
+  ASSERT_NE(zinhart::multi_core::random::philox4x32(42, 7)(), zinhart::multi_core::random::philox4x32(43, 7)());
+  engine.seed(42, 7);
+  ASSERT_EQ(bits[0], engine());
+  ASSERT_EQ(std::uint64_t{42}, engine.get_seed());
+  ASSERT_EQ(std::uint64_t{7}, engine.get_stream());
+  // usable with the std distributions
+  std::uniform_int_distribution<std::int32_t> dist(-5, 5);
+  for(std::uint32_t i = 0; i < 1000; ++i)
+  {
+	const std::int32_t value{dist(engine)};
+	ASSERT_GE(value, -5);
+	ASSERT_LE(value, 5);
+  }
+}
+
+template <class Distribution>
+  void check_independent_of_chunking(const Distribution & distribution)
+  {
+	using precision_type = typename Distribution::result_type;
+	std::random_device rd;
+	std::mt19937 mt(rd());
+	std::uniform_int_distribution<std::uint32_t> size_dist(0, 100000);
+	std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+	const std::uint32_t n_elements{size_dist(mt)};
+	const zinhart::multi_core::random::philox4x32 engine(rd(), rd());
+	// the reference takes every block in one go
+	const std::size_t n_blocks{(n_elements + Distribution::values_per_block - 1) / Distribution::values_per_block};
+	std::vector<std::uint32_t> bits(4 * n_blocks);
+	std::vector<precision_type> expected(n_blocks * Distribution::values_per_block);
+	engine.blocks(0, bits.data(), n_blocks);
+	distribution(bits.data(), expected.data(), n_blocks);
+	for(std::uint32_t n_threads : {std::uint32_t{1}, std::uint32_t{3}, thread_dist(mt)})
+	{
+	  zinhart::multi_core::thread_pool::scheduler thread_pool(n_threads);
+	  std::vector<precision_type> x(n_elements);
+	  zinhart::multi_core::parallel::generate_random(x.begin(), x.end(), distribution, engine, thread_pool);
+	  ASSERT_EQ(0, std::memcmp(expected.data(), x.data(), n_elements * sizeof(precision_type))) << n_threads;
+	}
+	// the streaming path writes the same values
+	const std::size_t threshold{zinhart::multi_core::simd::get_streaming_threshold()};
+	zinhart::multi_core::simd::set_streaming_threshold(1);
+	std::vector<precision_type> streamed(n_elements + 1);
+	zinhart::multi_core::parallel::generate_random(streamed.data() + 1, streamed.data() + streamed.size(), distribution, engine);
+	zinhart::multi_core::simd::set_streaming_threshold(threshold);
+	ASSERT_EQ(0, std::memcmp(expected.data(), streamed.data() + 1, n_elements * sizeof(precision_type)));
+  }
+
+TEST(random, generate_random_is_independent_of_chunking)
+{
+  check_independent_of_chunking(zinhart::multi_core::random::uniform_real<float>(-1.0f, 1.0f));
+  check_independent_of_chunking(zinhart::multi_core::random::uniform_real<double>(-1.0, 1.0));
+  check_independent_of_chunking(zinhart::multi_core::random::normal<float>(2.0f, 3.0f));
+  check_independent_of_chunking(zinhart::multi_core::random::normal<double>(2.0, 3.0));
+}
+
+template <class Distribution>
+  void check_moments(const Distribution & distribution, const double mean, const double variance, const double lower, const double upper)
+  {
+	using precision_type = typename Distribution::result_type;
+	const std::size_t n_elements{1 << 20};
+	std::vector<precision_type> x(n_elements);
+	zinhart::multi_core::parallel::generate_random(x.begin(), x.end(), distribution, zinhart::multi_core::random::philox4x32(2018));
+	double sum{0}, squares{0};
+	for(const precision_type & value : x)
+	{
+	  ASSERT_TRUE(std::isfinite(value));
+	  ASSERT_GE(value, lower);
+	  ASSERT_LT(value, upper);
+	  sum += value;
+	}
+	const double sample_mean{sum / n_elements};
+	for(const precision_type & value : x)
+	  squares += (value - sample_mean) * (value - sample_mean);
+	// a fixed seed so the tolerances, about six standard errors, never flake
+	ASSERT_NEAR(mean, sample_mean, 6 * std::sqrt(variance / n_elements));
+	ASSERT_NEAR(variance, squares / (n_elements - 1), 6 * variance * std::sqrt(2.0 / n_elements));
+  }
+
+TEST(random, distributions_have_the_right_moments)
+{
+  check_moments(zinhart::multi_core::random::uniform_real<float>(-2.0f, 6.0f), 2.0, 64.0 / 12.0, -2.0, 6.0);
+  check_moments(zinhart::multi_core::random::uniform_real<double>(-2.0, 6.0), 2.0, 64.0 / 12.0, -2.0, 6.0);
+  const double infinity{std::numeric_limits<double>::infinity()};
+  check_moments(zinhart::multi_core::random::normal<float>(1.0f, 0.5f), 1.0, 0.25, -infinity, infinity);
+  check_moments(zinhart::multi_core::random::normal<double>(1.0, 0.5), 1.0, 0.25, -infinity, infinity);
+}
@@ -0,0 +1,152 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+using namespace testing;
+
+TEST(parallel_reduce, padded_partials_do_not_share_cache_lines)
+{
+  std::vector<zinhart::multi_core::parallel::padded_partial<double>> partials(4);
+  for(std::uint32_t i = 1; i < partials.size(); ++i)
+	ASSERT_GE(reinterpret_cast<char*>(&partials[i].value) - reinterpret_cast<char*>(&partials[i - 1].value), std::ptrdiff_t{CACHE_LINE_SIZE + sizeof(double)});
+}
+
+TEST(parallel_reduce, reduce)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  std::uniform_int_distribution<std::int64_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::int64_t> x(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = int_dist(mt);
+  ASSERT_EQ(std::accumulate(x.begin(), x.end(), std::int64_t{7}), zinhart::multi_core::parallel::reduce(x.begin(), x.end(), std::int64_t{7}, thread_pool));
+  // non commutative operations still see the elements in order
+  auto max_op = [](std::int64_t a, std::int64_t b){ return std::max(a, b); };
+  ASSERT_EQ(std::accumulate(x.begin(), x.end(), std::numeric_limits<std::int64_t>::min(), max_op),
+	        zinhart::multi_core::parallel::reduce(x.begin(), x.end(), std::numeric_limits<std::int64_t>::min(), max_op, thread_pool));
+  std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+  ASSERT_EQ(std::string("_abcdefg"), zinhart::multi_core::parallel::reduce(words.begin(), words.end(), std::string("_"), std::plus<std::string>(), thread_pool));
+}
+
+TEST(parallel_reduce, transform_reduce_and_inner_product)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::int64_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<std::int64_t> x(n_elements), y(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	x[i] = int_dist(mt);
+	y[i] = int_dist(mt);
+  }
+  std::int64_t expected{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	expected += x[i] * x[i];
+  ASSERT_EQ(expected, zinhart::multi_core::parallel::transform_reduce(x.begin(), x.end(), std::int64_t{0}, std::plus<std::int64_t>(), [](std::int64_t v){ return v * v; }));
+  ASSERT_EQ(std::inner_product(x.begin(), x.end(), y.begin(), std::int64_t{3}), zinhart::multi_core::parallel::inner_product(x.begin(), x.end(), y.begin(), std::int64_t{3}));
+  auto minus = std::minus<std::int64_t>();
+  ASSERT_EQ(std::inner_product(x.begin(), x.end(), y.begin(), std::int64_t{0}, std::plus<std::int64_t>(), minus),
+	        zinhart::multi_core::parallel::inner_product(x.begin(), x.end(), y.begin(), std::int64_t{0}, std::plus<std::int64_t>(), minus));
+  ASSERT_EQ(std::int64_t{5}, zinhart::multi_core::parallel::inner_product(x.begin(), x.begin(), y.begin(), std::int64_t{5}));
+}
+
+TEST(parallel_reduce, compensated_sums)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  // every element is exactly representable and so is the sum, but a naive float sum drifts
+  std::vector<float> x(n_elements, 0.1f);
+  x[0] = 1.0e6f;
+  long double exact{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	exact += x[i];
+  const float kahan{zinhart::multi_core::parallel::kahan_sum(x.data(), n_elements, thread_pool)};
+  const float neumaier{zinhart::multi_core::parallel::neumaier_sum(x.data(), n_elements, thread_pool)};
+  ASSERT_NEAR(exact, kahan, std::abs(exact) * 4 * std::numeric_limits<float>::epsilon());
+  ASSERT_NEAR(exact, neumaier, std::abs(exact) * 4 * std::numeric_limits<float>::epsilon());
+
+  // catastrophic cancellation inside one chunk
+  std::vector<double> y{1.0, 1.0e100, 1.0, -1.0e100};
+  ASSERT_EQ(2.0, zinhart::multi_core::parallel::neumaier_sum(y.data(), y.size(), thread_pool));
+
+  // catastrophic cancellation across chunks, the ones vanish below the rounding of 1e100 and only survive in the corrections each chunk hands to the combine
+  zinhart::multi_core::thread_pool::scheduler four_threads(4);
+  const std::size_t n_cancelling{1 << 16};
+  std::vector<double> z(n_cancelling, 1.0), z_ones(n_cancelling, 1.0);
+  z.front() = 1.0e100;
+  z.back() = -1.0e100;
+  ASSERT_LT(1u, zinhart::multi_core::parallel::auto_chunks(n_cancelling, 2 * sizeof(double), four_threads));
+  ASSERT_EQ(double(n_cancelling - 2), zinhart::multi_core::parallel::kahan_sum(z.data(), n_cancelling, four_threads));
+  ASSERT_EQ(double(n_cancelling - 2), zinhart::multi_core::parallel::neumaier_sum(z.data(), n_cancelling, four_threads));
+  auto times = [](double p, double q){ return p * q; };
+  ASSERT_EQ(double(n_cancelling - 2), zinhart::multi_core::parallel::kahan_sum(z.data(), z_ones.data(), n_cancelling, times, four_threads));
+  ASSERT_EQ(double(n_cancelling - 2), zinhart::multi_core::parallel::neumaier_sum(z.data(), z_ones.data(), n_cancelling, times, four_threads));
+
+  std::vector<double> a(n_elements), b(n_elements);
+  std::uniform_real_distribution<double> real_dist(-1.0, 1.0);
+  long double exact_product{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	a[i] = real_dist(mt);
+	b[i] = real_dist(mt);
+	exact_product += static_cast<long double>(a[i] * b[i]);
+  }
+  auto product = [](double p, double q){ return p * q; };
+  ASSERT_NEAR(exact_product, zinhart::multi_core::parallel::kahan_sum(a.data(), b.data(), n_elements, product, thread_pool), 1e-9);
+  ASSERT_NEAR(exact_product, zinhart::multi_core::parallel::neumaier_sum(a.data(), b.data(), n_elements, product, thread_pool), 1e-9);
+  ASSERT_EQ(0.0, zinhart::multi_core::parallel::kahan_sum(a.data(), 0, thread_pool));
+}
+
+TEST(parallel_reduce, reproducible_sum_is_independent_of_thread_count)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, 4 * std::numeric_limits<std::uint16_t>::max());
+  std::uniform_real_distribution<double> exponent_dist(-20.0, 20.0);
+  std::uniform_real_distribution<double> real_dist(-1.0, 1.0);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<double> x(n_elements), y(n_elements);
+  std::vector<float> z(n_elements);
+  long double exact{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	x[i] = real_dist(mt) * std::pow(10.0, exponent_dist(mt));
+	y[i] = real_dist(mt);
+	z[i] = real_dist(mt);
+	exact += x[i];
+  }
+  auto product = [](double p, double q){ return p * q; };
+  zinhart::multi_core::thread_pool::scheduler reference_pool(1);
+  const double reference{zinhart::multi_core::parallel::reproducible_sum(x.data(), n_elements, reference_pool)};
+  const double reference_product{zinhart::multi_core::parallel::reproducible_sum(x.data(), y.data(), n_elements, product, reference_pool)};
+  const float reference_float{zinhart::multi_core::parallel::reproducible_sum(z.data(), n_elements, reference_pool)};
+  ASSERT_NEAR(exact, reference, std::abs(exact) * 1e-12 + 1e-6);
+  for(std::uint32_t n_threads : {2u, 3u, 5u, 8u})
+  {
+	zinhart::multi_core::thread_pool::scheduler thread_pool(n_threads);
+	const double sum{zinhart::multi_core::parallel::reproducible_sum(x.data(), n_elements, thread_pool)};
+	const double sum_product{zinhart::multi_core::parallel::reproducible_sum(x.data(), y.data(), n_elements, product, thread_pool)};
+	const float sum_float{zinhart::multi_core::parallel::reproducible_sum(z.data(), n_elements, thread_pool)};
+	// bitwise, not just close
+	ASSERT_EQ(0, std::memcmp(&reference, &sum, sizeof(double)));
+	ASSERT_EQ(0, std::memcmp(&reference_product, &sum_product, sizeof(double)));
+	ASSERT_EQ(0, std::memcmp(&reference_float, &sum_float, sizeof(float)));
+  }
+  ASSERT_EQ(0.0, zinhart::multi_core::parallel::reproducible_sum(x.data(), 0));
+}
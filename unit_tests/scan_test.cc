@@ -0,0 +1,113 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include <string>
+using namespace testing;
+
+TEST(parallel_scan, inclusive_scan)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  std::uniform_int_distribution<std::int64_t> int_dist(-1000, 1000);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::int64_t> x(n_elements), out_parallel(n_elements), out_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = int_dist(mt);
+  std::partial_sum(x.begin(), x.end(), out_serial.begin());
+  ASSERT_TRUE(out_parallel.end() == zinhart::multi_core::parallel::inclusive_scan(x.begin(), x.end(), out_parallel.begin(), thread_pool));
+  ASSERT_EQ(out_serial, out_parallel);
+
+  auto max_op = [](std::int64_t a, std::int64_t b){ return std::max(a, b); };
+  std::partial_sum(x.begin(), x.end(), out_serial.begin(), max_op);
+  zinhart::multi_core::parallel::inclusive_scan(x.begin(), x.end(), out_parallel.begin(), max_op, thread_pool);
+  ASSERT_EQ(out_serial, out_parallel);
+
+  // with an init, in place
+  std::int64_t running{100};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	out_serial[i] = running = running + x[i];
+  zinhart::multi_core::parallel::inclusive_scan(x.begin(), x.end(), x.begin(), std::plus<std::int64_t>(), std::int64_t{100}, thread_pool);
+  ASSERT_EQ(out_serial, x);
+}
+
+TEST(parallel_scan, exclusive_scan)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  std::uniform_int_distribution<std::uint32_t> int_dist(0, 10);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::uint32_t> x(n_elements), out_parallel(n_elements), out_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = int_dist(mt);
+  std::uint32_t running{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	out_serial[i] = running;
+	running += x[i];
+  }
+  ASSERT_TRUE(out_parallel.end() == zinhart::multi_core::parallel::exclusive_scan(x.begin(), x.end(), out_parallel.begin(), std::uint32_t{0}, thread_pool));
+  ASSERT_EQ(out_serial, out_parallel);
+  // in place
+  zinhart::multi_core::parallel::exclusive_scan(x.begin(), x.end(), x.begin(), std::uint32_t{0}, std::plus<std::uint32_t>(), thread_pool);
+  ASSERT_EQ(out_serial, x);
+
+  // non commutative
+  std::vector<std::string> words{"a", "b", "c", "d", "e"};
+  std::vector<std::string> prefixes(words.size());
+  zinhart::multi_core::parallel::exclusive_scan(words.begin(), words.end(), prefixes.begin(), std::string("_"), std::plus<std::string>(), thread_pool);
+  ASSERT_EQ((std::vector<std::string>{"_", "_a", "_ab", "_abc", "_abcd"}), prefixes);
+}
+
+TEST(parallel_scan, transform_inclusive_scan)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::int32_t> int_dist(-100, 100);
+  const std::uint32_t n_elements{size_dist(mt)};
+  std::vector<std::int32_t> x(n_elements);
+  std::vector<std::int64_t> out_parallel(n_elements), out_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x[i] = int_dist(mt);
+  auto square = [](std::int32_t v){ return std::int64_t{v} * v; };
+  std::int64_t running{0};
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	out_serial[i] = running = running + square(x[i]);
+  zinhart::multi_core::parallel::transform_inclusive_scan(x.begin(), x.end(), out_parallel.begin(), std::plus<std::int64_t>(), square);
+  ASSERT_EQ(out_serial, out_parallel);
+  zinhart::multi_core::parallel::transform_inclusive_scan(x.begin(), x.end(), out_parallel.begin(), std::plus<std::int64_t>(), square, std::int64_t{-5});
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	ASSERT_EQ(out_serial[i] - 5, out_parallel[i]);
+}
+
+TEST(parallel_scan, compensated_inclusive_scan)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<float> x(n_elements, 0.1f), out(n_elements);
+  x[0] = 1.0e6f;
+  ASSERT_EQ(out.data() + n_elements, zinhart::multi_core::parallel::compensated_inclusive_scan(x.data(), n_elements, out.data(), thread_pool));
+  long double exact{0};
+  // out[i] is rounded once and the correction drifts by at most 2 u^2 |S| per add, so |out[i] - S| <= (u + 2 i u^2) |S| < 2 u |S| = epsilon |S| while i < 2^23,
+  // a naive float scan drifts by about i * 0.025 here
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+  {
+	exact += x[i];
+	ASSERT_NEAR(exact, out[i], std::abs(exact) * 2 * std::numeric_limits<float>::epsilon());
+  }
+}
@@ -0,0 +1,81 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <random>
+#include <limits>
+using namespace testing;
+//no exceptions segfaults
+TEST(scheduler, constructor_and_destructor)
+{
+  zinhart::multi_core::thread_pool::scheduler thread_pool;
+}
+
+TEST(scheduler, call_add_task_and_add_priority_task)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, MAX_CPU_THREADS);
+  std::uint32_t results_size = size_dist(mt);
+  zinhart::multi_core::thread_pool::scheduler thread_pool;
+  std::vector<zinhart::multi_core::thread_pool::tasks::task_future<std::uint32_t>> results;
+  for(std::uint32_t i = 0, j = 0; i < results_size; ++i, ++j)
+  {	  
+	results.push_back(thread_pool.add_task([](std::uint32_t a, std::uint32_t b){ return a + b;}, i , j));
+	results.push_back(thread_pool.add_priority_task(i, [](std::uint32_t a, std::uint32_t b){ return a + b;}, i , j));
+  }
+  for(std::uint32_t i = 0; i < results_size; ++i)
+  {	  
+	ASSERT_EQ(2 * i, results[2 * i].get());
+	ASSERT_EQ(2 * i, results[2 * i + 1].get());
+  }
+}
+
+TEST(scheduler, scheduling_order)
+{
+  // a single worker so that tasks run one after another in the order the scheduler picks them
+  zinhart::multi_core::thread_pool::scheduler thread_pool(1);
+  std::promise<void> started, release;
+  std::shared_future<void> released(release.get_future());
+  std::vector<std::uint32_t> order;
+  zinhart::multi_core::thread_pool::tasks::task_future<void> blocker{thread_pool.add_task([&started, released](){ started.set_value(); released.wait(); })};
+  // make sure the worker is holding the blocker before anything else is queued
+  started.get_future().wait();
+  std::vector<zinhart::multi_core::thread_pool::tasks::task_future<void>> results;
+  for(std::uint32_t i = 0; i < 5; ++i)
+	results.push_back(thread_pool.add_task([&order](std::uint32_t i){ order.push_back(i); }, i));
+  results.push_back(thread_pool.add_priority_task(1, [&order](){ order.push_back(100); }));
+  results.push_back(thread_pool.add_priority_task(2, [&order](){ order.push_back(200); }));
+  release.set_value();
+  blocker.get();
+  for(std::uint32_t i = 0; i < results.size(); ++i)
+	results[i].get();
+  std::vector<std::uint32_t> expected{200, 100, 0, 1, 2, 3, 4};
+  ASSERT_EQ(expected, order);
+}
+
+TEST(scheduler, shared_by_push_task)
+{
+  ASSERT_EQ(zinhart::multi_core::thread_pool::size(), zinhart::multi_core::thread_pool::get_scheduler().size());
+  ASSERT_EQ(zinhart::multi_core::thread_pool::priority_thread_pool::size(), zinhart::multi_core::thread_pool::get_scheduler().size());
+}
+
+TEST(scheduler, task_managers_share_workers)
+{
+  zinhart::multi_core::thread_pool::scheduler thread_pool(2);
+  zinhart::multi_core::task_manager<std::uint32_t> first(thread_pool);
+  zinhart::multi_core::task_manager<zinhart::multi_core::heterogeneous> second(thread_pool);
+  ASSERT_EQ(first.size(), std::uint64_t{2});
+  ASSERT_EQ(second.size(), std::uint64_t{2});
+  zinhart::multi_core::slot_handle a = first.push(0, [](std::uint32_t a){ return a + 1; }, 1);
+  zinhart::multi_core::task_handle<std::string> b = second.push(0, [](std::string s){ return s; }, "apples");
+  ASSERT_EQ(first.get(a), std::uint32_t{2});
+  ASSERT_EQ(second.get(b), "apples");
+
+  // by default managers attach to the process wide scheduler
+  zinhart::multi_core::task_manager<std::uint32_t> third;
+  ASSERT_EQ(third.size(), std::uint64_t{zinhart::multi_core::thread_pool::get_scheduler().size()});
+
+  // a thread count still gets a private set of workers
+  zinhart::multi_core::task_manager<std::uint32_t> fourth(3);
+  ASSERT_EQ(fourth.size(), std::uint64_t{3});
+}
@@ -0,0 +1,87 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+using namespace testing;
+namespace parallel = zinhart::multi_core::parallel;
+
+TEST(search, find_if_returns_the_first_match)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 1 << 20);
+  std::uniform_int_distribution<std::int32_t> value_dist(0, 1 << 30);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  for(std::size_t trial = 0; trial < 10; ++trial)
+  {
+	const std::uint32_t n_elements{size_dist(mt)};
+	std::vector<std::int32_t> x(n_elements);
+	for(std::int32_t & value : x)
+	  value = value_dist(mt);
+	// matches grow rarer with each trial, the last trials usually have none
+	const std::int32_t cutoff{(1 << 30) - (1 << 30 >> trial)};
+	std::function<bool(std::int32_t)> above = [cutoff](std::int32_t value){ return value > cutoff; };
+	ASSERT_TRUE(std::find_if(x.begin(), x.end(), above) == parallel::find_if(x.begin(), x.end(), above, thread_pool));
+	ASSERT_TRUE(std::find_if_not(x.begin(), x.end(), above) == parallel::find_if_not(x.begin(), x.end(), above, thread_pool));
+	ASSERT_EQ(std::any_of(x.begin(), x.end(), above), parallel::any_of(x.begin(), x.end(), above, thread_pool));
+	ASSERT_EQ(std::all_of(x.begin(), x.end(), above), parallel::all_of(x.begin(), x.end(), above, thread_pool));
+	ASSERT_EQ(std::none_of(x.begin(), x.end(), above), parallel::none_of(x.begin(), x.end(), above, thread_pool));
+	ASSERT_EQ(std::count_if(x.begin(), x.end(), above), parallel::count_if(x.begin(), x.end(), above, thread_pool));
+	if(n_elements > 0)
+	{
+	  const std::int32_t value{x[n_elements / 2]};
+	  ASSERT_TRUE(std::find(x.begin(), x.end(), value) == parallel::find(x.begin(), x.end(), value, thread_pool));
+	  ASSERT_EQ(std::count(x.begin(), x.end(), value), parallel::count(x.begin(), x.end(), value, thread_pool));
+	}
+  }
+  std::vector<std::int32_t> empty;
+  ASSERT_TRUE(empty.end() == parallel::find(empty.begin(), empty.end(), 1));
+  ASSERT_FALSE(parallel::any_of(empty.begin(), empty.end(), [](std::int32_t){ return true; }));
+  ASSERT_TRUE(parallel::all_of(empty.begin(), empty.end(), [](std::int32_t){ return false; }));
+}
+
+TEST(search, a_match_at_the_front_stops_the_scan)
+{
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  const std::size_t n_elements{1 << 22};
+  std::vector<std::int32_t> x(n_elements, 0);
+  x[10] = 1;
+  std::atomic<std::size_t> calls{0};
+  auto is_one = [&calls](std::int32_t value){ calls.fetch_add(1, std::memory_order_relaxed); return value == 1; };
+  ASSERT_TRUE(x.begin() + 10 == parallel::find_if(x.begin(), x.end(), is_one, thread_pool));
+  ASSERT_LT(calls.load(), n_elements / 2);
+  calls = 0;
+  ASSERT_TRUE(parallel::any_of(x.begin(), x.end(), is_one, thread_pool));
+  ASSERT_LT(calls.load(), n_elements / 2);
+}
+
+TEST(search, extremes_match_std_positions)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 1 << 20);
+  // few distinct values so every extreme is tied many times over
+  std::uniform_int_distribution<std::int32_t> value_dist(-8, 8);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  for(std::size_t trial = 0; trial < 5; ++trial)
+  {
+	const std::uint32_t n_elements{size_dist(mt)};
+	std::vector<std::int32_t> x(n_elements);
+	for(std::int32_t & value : x)
+	  value = value_dist(mt);
+	ASSERT_TRUE(std::min_element(x.begin(), x.end()) == parallel::min_element(x.begin(), x.end(), thread_pool));
+	ASSERT_TRUE(std::max_element(x.begin(), x.end()) == parallel::max_element(x.begin(), x.end(), thread_pool));
+	ASSERT_TRUE(std::minmax_element(x.begin(), x.end()) == parallel::minmax_element(x.begin(), x.end(), thread_pool));
+	std::greater<std::int32_t> comp;
+	ASSERT_TRUE(std::min_element(x.begin(), x.end(), comp) == parallel::min_element(x.begin(), x.end(), comp, thread_pool));
+	ASSERT_TRUE(std::max_element(x.begin(), x.end(), comp) == parallel::max_element(x.begin(), x.end(), comp, thread_pool));
+	ASSERT_TRUE(std::minmax_element(x.begin(), x.end(), comp) == parallel::minmax_element(x.begin(), x.end(), comp, thread_pool));
+  }
+  std::vector<double> empty;
+  ASSERT_TRUE(empty.end() == parallel::min_element(empty.begin(), empty.end()));
+  ASSERT_TRUE(std::make_pair(empty.end(), empty.end()) == parallel::minmax_element(empty.begin(), empty.end()));
+}
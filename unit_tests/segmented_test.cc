@@ -0,0 +1,120 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+using namespace testing;
+namespace parallel = zinhart::multi_core::parallel;
+
+TEST(segmented, reduce_by_key_matches_a_serial_pass)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 1 << 18);
+  std::uniform_int_distribution<std::int64_t> value_dist(-1000, 1000);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  for(std::size_t trial = 0; trial < 12; ++trial)
+  {
+	const std::uint32_t n_elements{size_dist(mt)};
+	// runs from single elements up to runs that cover several chunks
+	std::uniform_int_distribution<std::uint32_t> run_dist(1, 1 + (n_elements >> (trial % 6 * 3)));
+	std::vector<std::int32_t> keys(n_elements);
+	std::vector<std::int64_t> values(n_elements);
+	std::int32_t key{0};
+	for(std::uint32_t i = 0, run = run_dist(mt); i < n_elements; ++i, --run)
+	{
+	  if(run == 0)
+	  {
+		key += 1 + (mt() % 3);
+		run = run_dist(mt);
+	  }
+	  keys[i] = key;
+	  values[i] = value_dist(mt);
+	}
+	// the same key compared by key / 4 merges neighbouring runs, first keeps the first value and checks the order of the combines
+	auto coarse = [](std::int32_t a, std::int32_t b){ return a / 4 == b / 4; };
+	auto first = [](std::int64_t a, std::int64_t b){ return a; };
+	std::vector<std::int32_t> expected_keys, expected_coarse_keys;
+	std::vector<std::int64_t> expected_sums, expected_firsts;
+	for(std::uint32_t i = 0; i < n_elements; ++i)
+	{
+	  if(i == 0 || keys[i] != keys[i - 1])
+	  {
+		expected_keys.push_back(keys[i]);
+		expected_sums.push_back(0);
+	  }
+	  expected_sums.back() += values[i];
+	  if(i == 0 || !coarse(keys[i - 1], keys[i]))
+	  {
+		expected_coarse_keys.push_back(keys[i]);
+		expected_firsts.push_back(values[i]);
+	  }
+	}
+	std::vector<std::int32_t> keys_output(n_elements);
+	std::vector<std::int64_t> values_output(n_elements);
+	auto ends = parallel::reduce_by_key(keys.begin(), keys.end(), values.begin(), keys_output.begin(), values_output.begin(), thread_pool);
+	ASSERT_EQ(expected_keys.size(), std::size_t(ends.first - keys_output.begin()));
+	ASSERT_EQ(expected_sums.size(), std::size_t(ends.second - values_output.begin()));
+	ASSERT_TRUE(std::equal(expected_keys.begin(), expected_keys.end(), keys_output.begin()));
+	ASSERT_TRUE(std::equal(expected_sums.begin(), expected_sums.end(), values_output.begin()));
+	ends = parallel::reduce_by_key(keys.begin(), keys.end(), values.begin(), keys_output.begin(), values_output.begin(), coarse, first, thread_pool);
+	ASSERT_EQ(expected_coarse_keys.size(), std::size_t(ends.first - keys_output.begin()));
+	ASSERT_TRUE(std::equal(expected_coarse_keys.begin(), expected_coarse_keys.end(), keys_output.begin()));
+	ASSERT_TRUE(std::equal(expected_firsts.begin(), expected_firsts.end(), values_output.begin()));
+  }
+}
+
+TEST(segmented, row_and_column_reductions_match_serial_loops)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::int32_t> value_dist(-100, 100);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  // wide, tall, square and empty shapes so each split of the work is taken
+  const std::vector<std::pair<std::size_t, std::size_t>> shapes{{1, 1 << 18}, {1 << 18, 1}, {3, 100000}, {100000, 3}, {700, 900}, {2, 1500}, {0, 5}, {5, 0}};
+  for(const std::pair<std::size_t, std::size_t> & shape : shapes)
+  {
+	const std::size_t n_rows{shape.first}, n_cols{shape.second};
+	std::vector<std::int64_t> integers(n_rows * n_cols);
+	std::vector<double> reals(n_rows * n_cols);
+	for(std::size_t i = 0; i < integers.size(); ++i)
+	  reals[i] = integers[i] = value_dist(mt);
+	for(const parallel::matrix_layout layout : {parallel::matrix_layout::row_major, parallel::matrix_layout::column_major})
+	{
+	  auto at = [&](std::size_t i, std::size_t j)
+	  {
+		return (layout == parallel::matrix_layout::row_major) ? zinhart::multi_core::idx2r(i, j, n_cols) : zinhart::multi_core::idx2c(i, j, n_rows);
+	  };
+	  std::vector<std::int64_t> row_sums(n_rows, 7), row_maxima(n_rows, std::numeric_limits<std::int64_t>::min()), col_sums(n_cols, 7), col_maxima(n_cols, std::numeric_limits<std::int64_t>::min());
+	  for(std::size_t i = 0; i < n_rows; ++i)
+		for(std::size_t j = 0; j < n_cols; ++j)
+		{
+		  row_sums[i] += integers[at(i, j)];
+		  col_sums[j] += integers[at(i, j)];
+		  row_maxima[i] = std::max(row_maxima[i], integers[at(i, j)]);
+		  col_maxima[j] = std::max(col_maxima[j], integers[at(i, j)]);
+		}
+	  auto maximum = [](std::int64_t a, std::int64_t b){ return std::max(a, b); };
+	  std::vector<std::int64_t> rows(n_rows), cols(n_cols);
+	  std::vector<double> real_rows(n_rows), real_cols(n_cols);
+	  ASSERT_TRUE(parallel::row_reduce(integers.begin(), layout, n_rows, n_cols, rows.begin(), std::int64_t{7}, thread_pool) == rows.end());
+	  ASSERT_EQ(row_sums, rows);
+	  ASSERT_TRUE(parallel::col_reduce(integers.begin(), layout, n_rows, n_cols, cols.begin(), std::int64_t{7}, thread_pool) == cols.end());
+	  ASSERT_EQ(col_sums, cols);
+	  parallel::row_reduce(integers.begin(), layout, n_rows, n_cols, rows.begin(), std::numeric_limits<std::int64_t>::min(), maximum, thread_pool);
+	  ASSERT_EQ(row_maxima, rows);
+	  parallel::col_reduce(integers.begin(), layout, n_rows, n_cols, cols.begin(), std::numeric_limits<std::int64_t>::min(), maximum, thread_pool);
+	  ASSERT_EQ(col_maxima, cols);
+	  // small integers sum exactly in double whatever the order of the additions
+	  parallel::row_reduce(reals.data(), layout, n_rows, n_cols, real_rows.data(), 7.0, thread_pool);
+	  parallel::col_reduce(reals.data(), layout, n_rows, n_cols, real_cols.data(), 7.0, thread_pool);
+	  for(std::size_t i = 0; i < n_rows; ++i)
+		ASSERT_EQ(double(row_sums[i]), real_rows[i]);
+	  for(std::size_t j = 0; j < n_cols; ++j)
+		ASSERT_EQ(double(col_sums[j]), real_cols[j]);
+	}
+  }
+}
@@ -0,0 +1,97 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+using namespace testing;
+namespace parallel = zinhart::multi_core::parallel;
+
+TEST(select, nth_element_places_the_sorted_element)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, 1 << 20);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  for(std::size_t trial = 0; trial < 6; ++trial)
+  {
+	const std::uint32_t n_elements{size_dist(mt)};
+	// odd trials draw from a few values so the splitters tie
+	std::uniform_int_distribution<std::int64_t> value_dist(0, trial % 2 ? 4 : std::numeric_limits<std::int64_t>::max());
+	std::vector<std::int64_t> x(n_elements);
+	for(std::int64_t & value : x)
+	  value = value_dist(mt);
+	std::vector<std::int64_t> sorted(x);
+	std::sort(sorted.begin(), sorted.end());
+	const std::size_t nth{std::uniform_int_distribution<std::size_t>(0, n_elements - 1)(mt)};
+	parallel::nth_element(x.begin(), x.begin() + nth, x.end(), thread_pool);
+	ASSERT_EQ(sorted[nth], x[nth]);
+	ASSERT_TRUE(std::all_of(x.begin(), x.begin() + nth, [&](std::int64_t value){ return value <= x[nth]; }));
+	ASSERT_TRUE(std::all_of(x.begin() + nth, x.end(), [&](std::int64_t value){ return value >= x[nth]; }));
+	// nothing was lost or duplicated
+	std::sort(x.begin(), x.end());
+	ASSERT_EQ(sorted, x);
+  }
+}
+
+TEST(select, partial_sort_sorts_the_front)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_real_distribution<double> real_dist(-1.0, 1.0);
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  const std::size_t n_elements{1 << 19};
+  std::vector<double> x(n_elements);
+  for(double & value : x)
+	value = real_dist(mt);
+  for(std::size_t middle : {std::size_t{0}, std::size_t{1}, std::size_t{1000}, n_elements / 2, n_elements})
+  {
+	std::vector<double> serial(x), parallel_x(x);
+	std::partial_sort(serial.begin(), serial.begin() + middle, serial.end(), std::greater<double>());
+	parallel::partial_sort(parallel_x.begin(), parallel_x.begin() + middle, parallel_x.end(), std::greater<double>(), thread_pool);
+	ASSERT_TRUE(std::equal(serial.begin(), serial.begin() + middle, parallel_x.begin()));
+	// the rest is a permutation of what was left
+	std::sort(serial.begin(), serial.end());
+	std::sort(parallel_x.begin(), parallel_x.end());
+	ASSERT_EQ(serial, parallel_x);
+  }
+}
+
+TEST(select, top_k_returns_values_and_positions)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  const std::size_t n_elements{1 << 19};
+  // few distinct scores so ties are broken by position
+  std::uniform_int_distribution<std::int32_t> score_dist(0, 1000);
+  std::vector<std::int32_t> scores(n_elements);
+  for(std::int32_t & score : scores)
+	score = score_dist(mt);
+  std::vector<std::size_t> order(n_elements);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j){ return scores[i] > scores[j]; });
+  // small k goes through the heaps, large k selects from every position
+  for(std::size_t k : {std::size_t{1}, std::size_t{100}, std::size_t{5000}, n_elements / 2, n_elements + 10})
+  {
+	std::vector<std::int32_t> values(k);
+	std::vector<std::size_t> indices(k);
+	const std::size_t n_selected{parallel::top_k(scores.begin(), scores.end(), k, values.begin(), indices.begin(), thread_pool)};
+	ASSERT_EQ(std::min(k, n_elements), n_selected);
+	for(std::size_t i = 0; i < n_selected; ++i)
+	{
+	  ASSERT_EQ(order[i], indices[i]);
+	  ASSERT_EQ(scores[order[i]], values[i]);
+	}
+  }
+  // the smallest under a reversed comparison
+  std::vector<std::int32_t> values(10);
+  std::vector<std::uint32_t> indices(10);
+  ASSERT_EQ(10u, parallel::top_k(scores.begin(), scores.end(), 10, values.begin(), indices.begin(), std::greater<std::int32_t>(), thread_pool));
+  ASSERT_EQ(*std::min_element(scores.begin(), scores.end()), values[0]);
+  ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+  std::vector<std::int32_t> empty;
+  ASSERT_EQ(0u, parallel::top_k(empty.begin(), empty.end(), 5, values.begin(), indices.begin()));
+}
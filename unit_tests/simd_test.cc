@@ -0,0 +1,389 @@
+#include <multi_core/multi_core.hh>
+#include <multi_core/parallel/simd.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+using namespace testing;
+using zinhart::multi_core::simd::instruction_set;
+
+// every instruction set this cpu can run, narrowest first
+static std::vector<instruction_set> supported_instruction_sets()
+{
+  std::vector<instruction_set> isas;
+  for(instruction_set isa : {instruction_set::generic, instruction_set::sse2, instruction_set::avx2, instruction_set::avx512})
+	if(static_cast<std::uint32_t>(isa) <= static_cast<std::uint32_t>(zinhart::multi_core::simd::detect_instruction_set()))
+	  isas.push_back(isa);
+  return isas;
+}
+
+template <class precision_type>
+  void check_elementwise_kernels()
+  {
+	std::random_device rd;
+	std::mt19937 mt(rd());
+	std::uniform_int_distribution<std::uint32_t> size_dist(0, 1000);
+	std::uniform_real_distribution<precision_type> real_dist(-1.0, 1.0);
+	std::uniform_int_distribution<std::uint32_t> pick_dist(0, 3);
+	for(instruction_set isa : supported_instruction_sets())
+	{
+	  ASSERT_EQ(isa, zinhart::multi_core::simd::set_instruction_set(isa)) << zinhart::multi_core::simd::to_string(isa);
+	  // odd sizes exercise the scalar tails
+	  const std::uint32_t n_elements{size_dist(mt)};
+	  const precision_type a{real_dist(mt)};
+	  std::vector<precision_type> x(n_elements), y(n_elements), y_serial, copied(n_elements + 1, precision_type{7});
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+	  {
+		x[i] = real_dist(mt);
+		y[i] = real_dist(mt);
+	  }
+	  y_serial = y;
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+		y_serial[i] = a * x[i] + y_serial[i];
+	  zinhart::multi_core::simd::saxpy(a, x.data(), y.data(), n_elements);
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+		ASSERT_NEAR(y_serial[i], y[i], 4 * std::numeric_limits<precision_type>::epsilon()) << zinhart::multi_core::simd::to_string(isa);
+
+	  // copy never writes past the end
+	  zinhart::multi_core::simd::copy(x.data(), copied.data(), n_elements);
+	  ASSERT_TRUE(std::equal(x.begin(), x.end(), copied.begin()));
+	  ASSERT_EQ(precision_type{7}, copied.back());
+
+	  // replace with -0 keeps the sign
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+		x[i] = pick_dist(mt);
+	  std::vector<precision_type> replaced(x);
+	  std::replace(replaced.begin(), replaced.end(), precision_type{2}, precision_type{-0.0});
+	  zinhart::multi_core::simd::replace(x.data(), n_elements, precision_type{2}, precision_type{-0.0});
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+	  {
+		ASSERT_EQ(replaced[i], x[i]);
+		ASSERT_EQ(std::signbit(replaced[i]), std::signbit(x[i]));
+	  }
+	}
+	zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+  }
+
+template <class precision_type>
+  void check_reduction_kernels()
+  {
+	std::random_device rd;
+	std::mt19937 mt(rd());
+	std::uniform_int_distribution<std::uint32_t> size_dist(0, 5000);
+	std::uniform_real_distribution<precision_type> real_dist(0.0, 1.0);
+	for(instruction_set isa : supported_instruction_sets())
+	{
+	  zinhart::multi_core::simd::set_instruction_set(isa);
+	  const std::uint32_t n_elements{size_dist(mt)};
+	  std::vector<precision_type> x(n_elements), y(n_elements);
+	  long double sum{0}, dot{0};
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+	  {
+		x[i] = real_dist(mt);
+		y[i] = real_dist(mt);
+		sum += x[i];
+		dot += static_cast<long double>(x[i]) * y[i];
+	  }
+	  // the plain reductions only reorder the additions, the error stays within the usual n * eps bound
+	  const precision_type bound{precision_type(n_elements) * std::numeric_limits<precision_type>::epsilon()};
+	  ASSERT_NEAR(sum, zinhart::multi_core::simd::accumulate(x.data(), n_elements), bound * sum + std::numeric_limits<precision_type>::min()) << zinhart::multi_core::simd::to_string(isa);
+	  ASSERT_NEAR(dot, zinhart::multi_core::simd::inner_product(x.data(), y.data(), n_elements), bound * dot + std::numeric_limits<precision_type>::min()) << zinhart::multi_core::simd::to_string(isa);
+	  // the compensated sums are correctly rounded up to a couple of ulps
+	  ASSERT_NEAR(sum, zinhart::multi_core::simd::kahan_sum(x.data(), n_elements), 2 * std::numeric_limits<precision_type>::epsilon() * sum) << zinhart::multi_core::simd::to_string(isa);
+	  ASSERT_NEAR(sum, zinhart::multi_core::simd::neumaier_sum(x.data(), n_elements), 2 * std::numeric_limits<precision_type>::epsilon() * sum) << zinhart::multi_core::simd::to_string(isa);
+	}
+	zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+  }
+
+TEST(simd, elementwise_kernels_match_scalar_loops)
+{
+  check_elementwise_kernels<float>();
+  check_elementwise_kernels<double>();
+}
+
+TEST(simd, reductions_are_accurate)
+{
+  check_reduction_kernels<float>();
+  check_reduction_kernels<double>();
+}
+
+TEST(simd, compensated_sums_recover_small_terms)
+{
+  for(instruction_set isa : supported_instruction_sets())
+  {
+	zinhart::multi_core::simd::set_instruction_set(isa);
+	// a naive float sum of 1 followed by many terms below half an ulp of 1 never moves
+	const std::uint32_t n_elements{1 << 16};
+	std::vector<float> x(n_elements, 1e-8f);
+	x[0] = 1.0f;
+	const float expected{static_cast<float>(1.0L + (n_elements - 1) * static_cast<long double>(1e-8f))};
+	ASSERT_FLOAT_EQ(expected, zinhart::multi_core::simd::kahan_sum(x.data(), n_elements)) << zinhart::multi_core::simd::to_string(isa);
+	ASSERT_FLOAT_EQ(expected, zinhart::multi_core::simd::neumaier_sum(x.data(), n_elements)) << zinhart::multi_core::simd::to_string(isa);
+	// neumaier also handles terms larger than the running sum
+	std::vector<double> cancelling{1.0, 1e100, 1.0, -1e100};
+	ASSERT_EQ(2.0, zinhart::multi_core::simd::neumaier_sum(cancelling.data(), cancelling.size()));
+  }
+  zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+}
+
+TEST(simd, requests_are_clamped_to_the_cpu)
+{
+  const instruction_set detected{zinhart::multi_core::simd::detect_instruction_set()};
+  ASSERT_EQ(detected, zinhart::multi_core::simd::set_instruction_set(instruction_set::avx512));
+  ASSERT_EQ(detected, zinhart::multi_core::simd::get_instruction_set());
+  ASSERT_EQ(instruction_set::generic, zinhart::multi_core::simd::set_instruction_set(instruction_set::generic));
+  zinhart::multi_core::simd::set_instruction_set(detected);
+}
+
+TEST(simd, other_types_and_iterators_fall_back)
+{
+  std::vector<std::int32_t> x(100), y(100, 1);
+  std::iota(x.begin(), x.end(), 0);
+  zinhart::multi_core::simd::saxpy(2, x.data(), y.data(), x.size());
+  ASSERT_EQ(std::int32_t{2 * 4950 + 100}, std::accumulate(y.begin(), y.end(), 0));
+  ASSERT_EQ(std::int64_t{4950}, zinhart::multi_core::simd::accumulate(x.begin(), x.size(), std::int64_t{0}));
+  // a float array summed into a double stays in double precision
+  std::vector<float> z(3, 0.1f);
+  ASSERT_EQ(3 * double(0.1f), zinhart::multi_core::simd::accumulate(z.data(), z.size(), 0.0));
+  std::vector<float> w(z.size());
+  zinhart::multi_core::simd::copy(z.begin(), w.begin(), z.size());
+  ASSERT_EQ(z, w);
+  std::vector<long double> v(10, 0.5L);
+  ASSERT_EQ(5.0L, zinhart::multi_core::simd::kahan_sum(v.data(), v.size()));
+  ASSERT_EQ(5.0L, zinhart::multi_core::simd::neumaier_sum(v.data(), v.size()));
+}
+
+// the textbook single chain the lane parallel sums must keep up with
+template <class precision_type>
+  precision_type single_chain_kahan(const std::vector<precision_type> & x)
+  {
+	precision_type sum{0}, compensation{0};
+	for(const precision_type & value : x)
+	{
+	  const precision_type y{value - compensation};
+	  const precision_type t{sum + y};
+	  compensation = (t - sum) - y;
+	  sum = t;
+	}
+	return sum;
+  }
+
+TEST(simd, lane_sums_are_as_accurate_as_a_single_chain)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1000, 100000);
+  std::uniform_real_distribution<float> mantissa_dist(-1.0f, 1.0f);
+  std::uniform_int_distribution<std::int32_t> exponent_dist(-20, 20);
+  const std::uint32_t n_elements{size_dist(mt)};
+  // terms spread over 40 binades with both signs are badly conditioned for a naive sum
+  std::vector<float> x(n_elements), ones(n_elements, 1.0f);
+  long double exact{0}, magnitude{0};
+  for(float & value : x)
+  {
+	value = std::ldexp(mantissa_dist(mt), exponent_dist(mt));
+	exact += value;
+	magnitude += std::abs(value);
+  }
+  // kahan's bound is (2 eps + O(n eps^2)) sum |x|, a naive sum only promises n eps sum |x|
+  const long double bound{(2 * std::numeric_limits<float>::epsilon() + n_elements * std::pow(std::numeric_limits<float>::epsilon(), 2)) * magnitude};
+  ASSERT_LE(std::abs(exact - single_chain_kahan(x)), bound);
+  for(instruction_set isa : supported_instruction_sets())
+  {
+	zinhart::multi_core::simd::set_instruction_set(isa);
+	ASSERT_LE(std::abs(exact - zinhart::multi_core::simd::kahan_sum(x.data(), n_elements)), bound) << zinhart::multi_core::simd::to_string(isa);
+	ASSERT_LE(std::abs(exact - zinhart::multi_core::simd::neumaier_sum(x.data(), n_elements)), bound) << zinhart::multi_core::simd::to_string(isa);
+  }
+  zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+  // the portable lanes behind the binary predicate versions
+  auto multiply = [](float a, float b){ return a * b; };
+  ASSERT_LE(std::abs(exact - zinhart::multi_core::kahan_sum(x.data(), ones.data(), n_elements, multiply)), bound);
+  ASSERT_LE(std::abs(exact - zinhart::multi_core::neumaier_sum(x.data(), ones.data(), n_elements, multiply)), bound);
+}
+
+TEST(simd, serial_compensated_sums_add_every_element)
+{
+  std::vector<double> x(1001);
+  std::iota(x.begin(), x.end(), 0.0);
+  std::vector<double> y(x.size(), 2.0);
+  auto multiply = [](double a, double b){ return a * b; };
+  ASSERT_EQ(500500.0, zinhart::multi_core::kahan_sum(x.data(), x.size()));
+  ASSERT_EQ(500500.0, zinhart::multi_core::neumaier_sum(x.data(), x.size()));
+  ASSERT_EQ(1001000.0, zinhart::multi_core::kahan_sum(x.data(), y.data(), x.size(), multiply));
+  ASSERT_EQ(1001000.0, zinhart::multi_core::neumaier_sum(x.data(), y.data(), x.size(), multiply));
+  ASSERT_EQ(0.0, zinhart::multi_core::kahan_sum(x.data(), 0));
+}
+
+template <class precision_type, class index_type>
+  void check_gather()
+  {
+	std::random_device rd;
+	std::mt19937 mt(rd());
+	std::uniform_int_distribution<std::uint32_t> size_dist(0, 1000);
+	std::uniform_real_distribution<precision_type> real_dist(-1.0, 1.0);
+	for(instruction_set isa : supported_instruction_sets())
+	{
+	  zinhart::multi_core::simd::set_instruction_set(isa);
+	  const std::uint32_t n_elements{size_dist(mt)}, n_sources{size_dist(mt) + 1};
+	  std::uniform_int_distribution<std::uint32_t> index_dist(0, n_sources - 1);
+	  std::vector<precision_type> x(n_sources), y(n_elements);
+	  std::vector<index_type> index(n_elements);
+	  for(precision_type & value : x)
+		value = real_dist(mt);
+	  for(index_type & i : index)
+		i = index_dist(mt);
+	  zinhart::multi_core::simd::gather(x.data(), index.data(), y.data(), n_elements);
+	  for(std::uint32_t i = 0; i < n_elements; ++i)
+		ASSERT_EQ(x[index[i]], y[i]) << zinhart::multi_core::simd::to_string(isa);
+	}
+	zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+  }
+
+TEST(simd, gathers_match_indexed_loads)
+{
+  static_assert(zinhart::multi_core::simd::has_index_kernel<const std::int32_t *>::value, "");
+  static_assert(zinhart::multi_core::simd::has_index_kernel<std::size_t *>::value, "");
+  static_assert(!zinhart::multi_core::simd::has_index_kernel<std::uint32_t *>::value, "");
+  static_assert(!zinhart::multi_core::simd::has_index_kernel<std::vector<std::int32_t>::iterator>::value, "");
+  check_gather<float, std::int32_t>();
+  check_gather<double, std::int32_t>();
+  check_gather<float, std::int64_t>();
+  check_gather<double, std::int64_t>();
+  check_gather<double, std::size_t>();
+  // indices without a kernel and iterators take the prefetching loop
+  check_gather<float, std::uint32_t>();
+  std::vector<int> x{5, 6, 7}, y(4);
+  std::vector<std::uint16_t> index{2, 0, 2, 1};
+  zinhart::multi_core::simd::gather(x.begin(), index.begin(), y.begin(), index.size());
+  ASSERT_EQ((std::vector<int>{7, 5, 7, 6}), y);
+  // scatter in order, the last of a repeated index wins
+  std::vector<int> z(3, 0);
+  zinhart::multi_core::simd::scatter(y.begin(), index.begin(), z.begin(), index.size());
+  ASSERT_EQ((std::vector<int>{5, 6, 7}), z);
+}
+
+TEST(simd, streaming_stores_match_cached_stores)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 3000);
+  std::uniform_int_distribution<std::uint32_t> offset_dist(0, 63);
+  std::uniform_int_distribution<std::uint32_t> byte_dist(0, 255);
+  for(instruction_set isa : supported_instruction_sets())
+  {
+	zinhart::multi_core::simd::set_instruction_set(isa);
+	// odd sizes at odd offsets exercise the cached head and tail
+	const std::uint32_t n_bytes{size_dist(mt)}, source_offset{offset_dist(mt)}, destination_offset{offset_dist(mt)};
+	std::vector<unsigned char> source(n_bytes + 64), destination(n_bytes + 128, 0xAB);
+	for(unsigned char & byte : source)
+	  byte = byte_dist(mt);
+	zinhart::multi_core::simd::stream_copy_bytes(source.data() + source_offset, destination.data() + destination_offset, n_bytes);
+	ASSERT_TRUE(std::equal(source.begin() + source_offset, source.begin() + source_offset + n_bytes, destination.begin() + destination_offset)) << zinhart::multi_core::simd::to_string(isa);
+	ASSERT_TRUE(std::all_of(destination.begin(), destination.begin() + destination_offset, [](unsigned char byte){ return byte == 0xAB; }));
+	ASSERT_TRUE(std::all_of(destination.begin() + destination_offset + n_bytes, destination.end(), [](unsigned char byte){ return byte == 0xAB; }));
+
+	// fills at every element alignment, -0 keeps the sign
+	std::vector<double> doubles(n_bytes + 2, 1.0);
+	zinhart::multi_core::simd::stream_fill(doubles.data() + 1, n_bytes, -0.0);
+	ASSERT_EQ(1.0, doubles.front());
+	ASSERT_EQ(1.0, doubles.back());
+	for(std::uint32_t i = 1; i <= n_bytes; ++i)
+	  ASSERT_TRUE(doubles[i] == 0.0 && std::signbit(doubles[i])) << zinhart::multi_core::simd::to_string(isa);
+	std::vector<std::uint16_t> shorts(n_bytes + 2, 1);
+	zinhart::multi_core::simd::stream_fill(shorts.data() + 1, n_bytes, std::uint16_t{0xBEEF});
+	ASSERT_EQ(std::size_t{n_bytes}, std::size_t(std::count(shorts.begin(), shorts.end(), std::uint16_t{0xBEEF})));
+	// a 3 byte value is not a power of two and goes through the cache
+	struct rgb { unsigned char r, g, b; };
+	std::vector<rgb> pixels(n_bytes, rgb{0, 0, 0});
+	zinhart::multi_core::simd::stream_fill(pixels.data(), pixels.size(), rgb{1, 2, 3});
+	ASSERT_TRUE(std::all_of(pixels.begin(), pixels.end(), [](const rgb & p){ return p.r == 1 && p.g == 2 && p.b == 3; }));
+
+	std::uint32_t counter{0};
+	std::vector<std::uint32_t> generated(n_bytes);
+	zinhart::multi_core::simd::stream_generate(generated.data(), generated.size(), [&counter](){ return counter++; });
+	for(std::uint32_t i = 0; i < n_bytes; ++i)
+	  ASSERT_EQ(i, generated[i]);
+  }
+  zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+  // iterators that are not pointers go through the cache
+  std::vector<float> x(100, 2.0f), y(100);
+  zinhart::multi_core::simd::stream_copy(x.begin(), y.begin(), x.size());
+  ASSERT_EQ(x, y);
+  zinhart::multi_core::simd::stream_fill(y.begin(), y.size(), 3.0f);
+  ASSERT_EQ(300.0f, std::accumulate(y.begin(), y.end(), 0.0f));
+}
+
+// values as wide as the largest register, filled from a value aligned base so they take the streaming path
+template <std::size_t n_doubles>
+  struct alignas(n_doubles * sizeof(double)) wide_value { double lanes[n_doubles]; };
+
+template <std::size_t n_doubles>
+  void check_wide_fill(const std::size_t n_values)
+  {
+	using value_type = wide_value<n_doubles>;
+	value_type value;
+	for(std::size_t i = 0; i < n_doubles; ++i)
+	  value.lanes[i] = double(i + 1);
+	// room for one value of guard on each side after aligning the base
+	std::vector<double> storage((n_values + 3) * n_doubles, -1.0);
+	const std::size_t misalignment{reinterpret_cast<std::uintptr_t>(storage.data()) % sizeof(value_type)};
+	double * base{storage.data() + (misalignment == 0 ? 0 : (sizeof(value_type) - misalignment) / sizeof(double))};
+	value_type * values{reinterpret_cast<value_type *>(base) + 1};
+	for(instruction_set isa : supported_instruction_sets())
+	{
+	  zinhart::multi_core::simd::set_instruction_set(isa);
+	  std::fill(storage.begin(), storage.end(), -1.0);
+	  zinhart::multi_core::simd::stream_fill(values, n_values, value);
+	  for(std::size_t i = 0; i < n_values; ++i)
+		for(std::size_t lane = 0; lane < n_doubles; ++lane)
+		  ASSERT_EQ(double(lane + 1), values[i].lanes[lane]) << zinhart::multi_core::simd::to_string(isa) << " value " << i << " lane " << lane;
+	  for(std::size_t lane = 0; lane < n_doubles; ++lane)
+	  {
+		ASSERT_EQ(-1.0, values[-1].lanes[lane]);
+		ASSERT_EQ(-1.0, values[n_values].lanes[lane]);
+	  }
+	}
+	zinhart::multi_core::simd::set_instruction_set(zinhart::multi_core::simd::detect_instruction_set());
+  }
+
+TEST(simd, streaming_fills_of_values_wider_than_a_register)
+{
+  for(std::size_t n_values : {0, 1, 3, 17, 1000})
+  {
+	check_wide_fill<4>(n_values);
+	check_wide_fill<8>(n_values);
+  }
+}
+
+TEST(simd, parallel_outputs_past_the_threshold_stream)
+{
+  const std::size_t threshold{zinhart::multi_core::simd::get_streaming_threshold()};
+  ASSERT_GT(threshold, std::size_t{0});
+  ASSERT_TRUE(zinhart::multi_core::simd::use_streaming_stores(threshold));
+  ASSERT_FALSE(zinhart::multi_core::simd::use_streaming_stores(threshold - 1));
+  // forces every output through the streaming path
+  zinhart::multi_core::simd::set_streaming_threshold(1);
+  ASSERT_EQ(std::size_t{1}, zinhart::multi_core::simd::get_streaming_threshold());
+  const std::size_t n_elements{100003};
+  std::vector<double> x(n_elements), y(n_elements + 1, -1.0);
+  std::iota(x.begin(), x.end(), 0.0);
+  zinhart::multi_core::parallel::copy(x.data(), x.data() + n_elements, y.data() + 1);
+  ASSERT_EQ(-1.0, y[0]);
+  ASSERT_TRUE(std::equal(x.begin(), x.end(), y.begin() + 1));
+  // the thread_id / n_threads front ends stream too, each call covers its share of the whole output
+  std::fill(y.begin(), y.end(), -1.0);
+  for(std::uint32_t thread_id = 0; thread_id < 3; ++thread_id)
+	zinhart::multi_core::async::copy(x.data(), y.data() + 1, n_elements, 3, thread_id);
+  ASSERT_EQ(-1.0, y[0]);
+  ASSERT_TRUE(std::equal(x.begin(), x.end(), y.begin() + 1));
+  zinhart::multi_core::parallel::fill(y.data() + 1, y.data() + y.size(), 0.5);
+  ASSERT_EQ(-1.0, y[0]);
+  ASSERT_EQ(0.5 * n_elements, std::accumulate(y.begin() + 1, y.end(), 0.0));
+  std::vector<std::int32_t> z(n_elements);
+  zinhart::multi_core::parallel::fill(z.begin(), z.end(), 7);
+  ASSERT_EQ(std::int64_t{7} * n_elements, std::accumulate(z.begin(), z.end(), std::int64_t{0}));
+  zinhart::multi_core::simd::set_streaming_threshold(threshold);
+}
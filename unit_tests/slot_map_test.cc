@@ -0,0 +1,66 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <random>
+#include <limits>
+#include <memory>
+using namespace testing;
+TEST(slot_map, insert_and_at)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, 100);
+  const std::uint32_t n_values{size_dist(mt)};
+  zinhart::multi_core::slot_map<std::uint32_t> test_map;
+  std::vector<zinhart::multi_core::slot_handle> handles;
+  std::uint32_t i{0};
+  for(i = 0; i < n_values; ++i)
+	handles.push_back(test_map.insert(std::uint32_t{i}));
+  ASSERT_EQ(n_values, test_map.size());
+  ASSERT_EQ(n_values, test_map.capacity());
+  for(i = 0; i < n_values; ++i)
+  {
+	ASSERT_TRUE(test_map.contains(handles[i]));
+	ASSERT_EQ(i, test_map.at(handles[i]));
+  }
+  ASSERT_FALSE(test_map.contains(zinhart::multi_core::slot_handle()));
+  ASSERT_THROW(test_map.at(zinhart::multi_core::slot_handle()), std::out_of_range);
+}
+
+TEST(slot_map, erase_recycles_slots)
+{
+  zinhart::multi_core::slot_map<std::uint32_t> test_map;
+  zinhart::multi_core::slot_handle a = test_map.insert(1);
+  zinhart::multi_core::slot_handle b = test_map.insert(2);
+  test_map.erase(a);
+  ASSERT_FALSE(test_map.contains(a));
+  ASSERT_TRUE(test_map.contains(b));
+  ASSERT_EQ(std::uint32_t{1}, test_map.size());
+  ASSERT_THROW(test_map.erase(a), std::out_of_range);
+
+  // the freed slot is reused with a new generation so the old handle stays stale
+  zinhart::multi_core::slot_handle c = test_map.insert(3);
+  ASSERT_EQ(a.get_index(), c.get_index());
+  ASSERT_NE(a, c);
+  ASSERT_FALSE(test_map.contains(a));
+  ASSERT_EQ(std::uint32_t{3}, test_map.at(c));
+  ASSERT_EQ(std::uint32_t{2}, test_map.capacity());
+}
+
+TEST(slot_map, move_only_values)
+{
+  zinhart::multi_core::slot_map<std::unique_ptr<std::uint32_t>> test_map;
+  std::vector<zinhart::multi_core::slot_handle> handles;
+  std::uint32_t i{0}, sum{0};
+  // enough inserts to force the slots to be moved on reallocation
+  for(i = 0; i < 1000; ++i)
+	handles.push_back(test_map.insert(std::unique_ptr<std::uint32_t>(new std::uint32_t(i))));
+  for(i = 0; i < 1000; ++i)
+	ASSERT_EQ(i, *test_map.at(handles[i]));
+  for(i = 0; i < 1000; i += 2)
+	test_map.erase(handles[i]);
+  test_map.for_each([&sum](std::unique_ptr<std::uint32_t> & value){ sum += *value; });
+  ASSERT_EQ(std::uint32_t{250000}, sum);
+  test_map.clear();
+  ASSERT_EQ(std::uint32_t{0}, test_map.size());
+}
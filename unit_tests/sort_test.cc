@@ -0,0 +1,81 @@
+#include <multi_core/multi_core.hh>
+#include <gtest/gtest.h>
+#include <random>
+#include <limits>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <memory>
+using namespace testing;
+
+TEST(parallel_sort, merge_path)
+{
+  std::vector<std::int32_t> a{1, 3, 3, 5}, b{2, 3, 4};
+  auto comp = std::less<std::int32_t>();
+  ASSERT_EQ(std::uint32_t{0}, zinhart::multi_core::parallel::merge_path(0, a.begin(), a.size(), b.begin(), b.size(), comp));
+  ASSERT_EQ(std::uint32_t{1}, zinhart::multi_core::parallel::merge_path(1, a.begin(), a.size(), b.begin(), b.size(), comp));
+  ASSERT_EQ(std::uint32_t{1}, zinhart::multi_core::parallel::merge_path(2, a.begin(), a.size(), b.begin(), b.size(), comp));
+  // ties are taken from a first
+  ASSERT_EQ(std::uint32_t{2}, zinhart::multi_core::parallel::merge_path(3, a.begin(), a.size(), b.begin(), b.size(), comp));
+  ASSERT_EQ(std::uint32_t{3}, zinhart::multi_core::parallel::merge_path(4, a.begin(), a.size(), b.begin(), b.size(), comp));
+  ASSERT_EQ(std::uint32_t{4}, zinhart::multi_core::parallel::merge_path(7, a.begin(), a.size(), b.begin(), b.size(), comp));
+}
+
+TEST(parallel_sort, sort)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 4 * std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  std::uniform_real_distribution<double> real_dist(-1000.0, 1000.0);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<double> x_parallel(n_elements), x_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x_serial[i] = x_parallel[i] = real_dist(mt);
+  zinhart::multi_core::parallel::sort(x_parallel.begin(), x_parallel.end(), thread_pool);
+  std::sort(x_serial.begin(), x_serial.end());
+  ASSERT_EQ(x_serial, x_parallel);
+  zinhart::multi_core::parallel::sort(x_parallel.begin(), x_parallel.end(), std::greater<double>(), thread_pool);
+  std::sort(x_serial.begin(), x_serial.end(), std::greater<double>());
+  ASSERT_EQ(x_serial, x_parallel);
+}
+
+TEST(parallel_sort, stable_sort)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(0, 4 * std::numeric_limits<std::uint16_t>::max());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, 16);
+  // lots of ties
+  std::uniform_int_distribution<std::int32_t> key_dist(0, 100);
+  const std::uint32_t n_elements{size_dist(mt)};
+  zinhart::multi_core::thread_pool::scheduler thread_pool(thread_dist(mt));
+  std::vector<std::pair<std::int32_t, std::uint32_t>> x_parallel(n_elements), x_serial(n_elements);
+  for(std::uint32_t i = 0; i < n_elements; ++i)
+	x_serial[i] = x_parallel[i] = std::make_pair(key_dist(mt), i);
+  auto by_key = [](const std::pair<std::int32_t, std::uint32_t> & a, const std::pair<std::int32_t, std::uint32_t> & b){ return a.first < b.first; };
+  zinhart::multi_core::parallel::stable_sort(x_parallel.begin(), x_parallel.end(), by_key, thread_pool);
+  std::stable_sort(x_serial.begin(), x_serial.end(), by_key);
+  ASSERT_EQ(x_serial, x_parallel);
+}
+
+TEST(parallel_sort, move_only_and_small_inputs)
+{
+  zinhart::multi_core::thread_pool::scheduler thread_pool(4);
+  std::vector<std::unique_ptr<std::int32_t>> x;
+  for(std::int32_t i = 0; i < 1000; ++i)
+	x.emplace_back(new std::int32_t((i * 7919) % 1000));
+  zinhart::multi_core::parallel::sort(x.begin(), x.end(), [](const std::unique_ptr<std::int32_t> & a, const std::unique_ptr<std::int32_t> & b){ return *a < *b; }, thread_pool);
+  for(std::int32_t i = 0; i < 1000; ++i)
+	ASSERT_EQ(i, *x[i]);
+  for(std::uint32_t n_elements = 0; n_elements < 20; ++n_elements)
+  {
+	std::vector<std::int32_t> y(n_elements);
+	for(std::uint32_t i = 0; i < n_elements; ++i)
+	  y[i] = n_elements - i;
+	zinhart::multi_core::parallel::sort(y.begin(), y.end(), thread_pool);
+	ASSERT_TRUE(std::is_sorted(y.begin(), y.end()));
+  }
+}
@@ -4,6 +4,10 @@
 #include <random>
 #include <limits>
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 using namespace testing;
 
 
@@ -137,16 +141,16 @@ TEST(task_manager, push_wait)
 TEST(task_manager, push)
 {
   zinhart::multi_core::task_manager<example> t;
-  t.push(0, [](char a)
+  zinhart::multi_core::slot_handle a = t.push(0, [](char a)
 	{
 	  example x; 
 	  x.set_uchar(a);
 	  return x;
 	}, 'a'
   );
-  ASSERT_EQ(t.get(0).get_uchar(), 'a');
+  ASSERT_EQ(t.get(a).get_uchar(), 'a');
   
-  t.push(0, [](std::uint32_t num)
+  zinhart::multi_core::slot_handle b = t.push(0, [](std::uint32_t num)
 	{
 	  example x; 
 	  x.set_uint(num);
@@ -154,32 +158,31 @@ TEST(task_manager, push)
 	},
 	1
   );
-  ASSERT_EQ(t.get(1).get_uint(), 1);
+  ASSERT_EQ(t.get(b).get_uint(), 1);
 
-  t.push(0, [](std::string s)
+  zinhart::multi_core::slot_handle c = t.push(0, [](std::string s)
 	{
 	  example x; 
 	  x.set_string(s);
 	  return x;
 	}, "apples"
   );
- example p(t.get(2));
+ example p(t.get(c));
  ASSERT_EQ(p.get_string(), "apples"); 
 }
 
 TEST(task_manager, push_at)
 {
   zinhart::multi_core::task_manager<example> t;
-  t.push(0, [](char a)
+  zinhart::multi_core::slot_handle a = t.push(0, [](char a)
 	{
 	  example x; 
 	  x.set_uchar(a);
 	  return x;
 	}, 'a'
   );
-  ASSERT_EQ(t.get(0).get_uchar(), 'a');
   
-  t.push(0, [](std::uint32_t num)
+  zinhart::multi_core::slot_handle b = t.push(0, [](std::uint32_t num)
 	{
 	  example x; 
 	  x.set_uint(num);
@@ -187,29 +190,25 @@ TEST(task_manager, push_at)
 	},
 	1
   );
-  ASSERT_EQ(t.get(1).get_uint(), 1);
 
-  t.push(0, [](std::string s)
+  zinhart::multi_core::slot_handle c = t.push(0, [](std::string s)
 	{
 	  example x; 
 	  x.set_string(s);
 	  return x;
 	}, "apples"
   );
- example p(t.get(2));
- ASSERT_EQ(p.get_string(), "apples"); 
-
 
- t.push_at(1, 0, [](char a)
+ t.push_at(b, 0, [](char a)
 	{
 	  example x; 
 	  x.set_uchar(a);
 	  return x;
 	}, 'a'
   );
- ASSERT_EQ(t.get(1).get_uchar(), 'a');
+ ASSERT_EQ(t.get(b).get_uchar(), 'a');
   
- t.push_at(2,0, [](std::uint32_t num)
+ t.push_at(c, 0, [](std::uint32_t num)
 	{
 	  example x; 
 	  x.set_uint(num);
@@ -217,22 +216,191 @@ TEST(task_manager, push_at)
 	},
 	1
   );
- ASSERT_EQ(t.get(2).get_uint(), 1);
+ ASSERT_EQ(t.get(c).get_uint(), 1);
 
- t.push_at(0, 0, [](std::string s)
+ t.push_at(a, 0, [](std::string s)
 	{
 	  example x; 
 	  x.set_string(s);
 	  return x;
 	}, "apples"
   );
- example w(t.get(0));
+ example w(t.get(a));
  ASSERT_EQ(w.get_string(), "apples"); 
+
+ // a consumed handle cannot be overwritten
+ ASSERT_THROW(t.push_at(a, 0, [](){ return example(); }), std::out_of_range);
+}
+
+TEST(task_manager, push_at_completions)
+{
+  zinhart::multi_core::task_manager<std::uint32_t> t(2);
+  std::promise<void> gate;
+  std::shared_future<void> opened{gate.get_future().share()};
+  std::atomic<bool> replacement_finished{false};
+  zinhart::multi_core::slot_handle a = t.push(0, [](){ return std::uint32_t{1}; });
+  // the discarded task finishes first, the replacement only once the gate opens
+  t.push_at(a, 0, [opened, &replacement_finished]()
+	{
+	  opened.wait();
+	  replacement_finished = true;
+	  return std::uint32_t{2};
+	}
+  );
+  std::thread opener([&gate]()
+	{
+	  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	  gate.set_value();
+	}
+  );
+  zinhart::multi_core::slot_handle handle;
+  // the completion of the discarded task must not be reported for the slot
+  const bool completed{t.next_completed(handle)};
+  const bool finished_when_reported{replacement_finished};
+  opener.join();
+  ASSERT_TRUE(completed);
+  ASSERT_TRUE(finished_when_reported);
+  ASSERT_EQ(handle, a);
+  ASSERT_EQ(t.get(handle), std::uint32_t{2});
+  ASSERT_FALSE(t.next_completed(handle));
 }
+
+TEST(task_manager, slot_recycling)
+{
+  zinhart::multi_core::task_manager<std::uint32_t> t;
+  zinhart::multi_core::slot_handle first = t.push(0, [](std::uint32_t a){ return a; }, 1);
+  ASSERT_TRUE(t.valid(first));
+  ASSERT_EQ(t.pending(), std::uint64_t{1});
+  ASSERT_EQ(t.get(first), std::uint32_t{1});
+  ASSERT_FALSE(t.valid(first));
+  ASSERT_EQ(t.pending(), std::uint64_t{0});
+  ASSERT_THROW(t.get(first), std::out_of_range);
+
+  // every push after the first consumed result reuses its slot, but old handles stay stale
+  for(std::uint32_t i = 0; i < 100; ++i)
+  {
+	zinhart::multi_core::slot_handle current = t.push(0, [](std::uint32_t a){ return a; }, i);
+	ASSERT_EQ(current.get_index(), first.get_index());
+	ASSERT_NE(current, first);
+	ASSERT_FALSE(t.valid(first));
+	ASSERT_EQ(t.get(current), i);
+  }
+  ASSERT_EQ(t.pending(), std::uint64_t{0});
+}
+
 TEST(task_manager, resize)
 {
-  zinhart::multi_core::task_manager<example> t;
+  zinhart::multi_core::task_manager<example> t(2);
   std::uint32_t old_size = t.size();
   t.resize(old_size + 10);
   ASSERT_EQ(t.size(), old_size +10);
+  // a manager on the process wide scheduler must not resize it for everyone else
+  zinhart::multi_core::task_manager<example> shared;
+  const std::uint64_t shared_size{zinhart::multi_core::thread_pool::get_scheduler().size()};
+  ASSERT_THROW(shared.resize(shared_size + 10), std::logic_error);
+  ASSERT_EQ(shared_size, zinhart::multi_core::thread_pool::get_scheduler().size());
+  zinhart::multi_core::task_manager<zinhart::multi_core::heterogeneous> heterogeneous_shared;
+  ASSERT_THROW(heterogeneous_shared.resize(shared_size + 10), std::logic_error);
+  ASSERT_EQ(shared_size, zinhart::multi_core::thread_pool::get_scheduler().size());
+}
+
+TEST(task_manager, next_completed)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> size_dist(1, 50);
+  std::uniform_int_distribution<std::uint32_t> sleep_dist(0, 5);
+  const std::uint32_t n_tasks{size_dist(mt)};
+  zinhart::multi_core::task_manager<std::uint32_t> t;
+  std::vector<zinhart::multi_core::slot_handle> handles;
+  std::uint32_t i{0};
+  for(i = 0; i < n_tasks; ++i)
+	handles.push_back(t.push(0, [](std::uint32_t a, std::uint32_t sleep_ms)
+	  {
+		std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+		return a * a;
+	  }, i, sleep_dist(mt)
+	));
+  // consume the first task in submission order, it should not be yielded again
+  ASSERT_EQ(t.get(handles[0]), std::uint32_t{0});
+  std::vector<bool> seen(n_tasks, false);
+  zinhart::multi_core::slot_handle handle;
+  std::uint32_t result;
+  for(i = 1; i < n_tasks; ++i)
+  {
+	ASSERT_TRUE(t.next_completed(handle, result));
+	std::uint32_t index = std::find(handles.begin(), handles.end(), handle) - handles.begin();
+	ASSERT_LT(index, n_tasks);
+	ASSERT_FALSE(seen[index]);
+	ASSERT_EQ(result, index * index);
+	seen[index] = true;
+  }
+  ASSERT_FALSE(t.next_completed(handle, result));
+
+  zinhart::multi_core::slot_handle last = t.push(0, [](){ return std::uint32_t{7}; });
+  ASSERT_TRUE(t.next_completed(handle));
+  ASSERT_EQ(handle, last);
+  ASSERT_EQ(t.get(handle), std::uint32_t{7});
+  ASSERT_FALSE(t.next_completed(handle));
+}
+
+// counts the copies made of a result on its way back to the caller
+struct copy_counter
+{
+  static std::uint32_t copies;
+  std::uint32_t id{0};
+  copy_counter() = default;
+  copy_counter(const std::uint32_t id)
+	: id(id)
+  {}
+  copy_counter(const copy_counter & other)
+	: id(other.id)
+  { ++copies; }
+  copy_counter(copy_counter &&) = default;
+  copy_counter & operator = (const copy_counter & other)
+  { id = other.id; ++copies; return *this; }
+  copy_counter & operator = (copy_counter &&) = default;
+};
+std::uint32_t copy_counter::copies = 0;
+
+TEST(task_manager, heterogeneous_push_wait)
+{
+  zinhart::multi_core::task_manager<zinhart::multi_core::heterogeneous> t;
+  ASSERT_EQ(t.push_wait(0, [](char a){ return a; }, 'a'), 'a');
+  ASSERT_EQ(t.push_wait(0, [](std::uint32_t num){ return num; }, 1), std::uint32_t{1});
+  ASSERT_EQ(t.push_wait(0, [](std::string s){ return s; }, "apples"), "apples");
+}
+
+TEST(task_manager, heterogeneous_push)
+{
+  zinhart::multi_core::task_manager<zinhart::multi_core::heterogeneous> t;
+  zinhart::multi_core::task_handle<char> a = t.push(0, [](char a){ return a; }, 'a');
+  zinhart::multi_core::task_handle<std::uint32_t> b = t.push(0, [](std::uint32_t num){ return num; }, 1);
+  zinhart::multi_core::task_handle<std::string> c = t.push(0, [](std::string s){ return s; }, "apples");
+  zinhart::multi_core::task_handle<std::unique_ptr<std::uint32_t>> d = t.push(0, [](){ return std::unique_ptr<std::uint32_t>(new std::uint32_t(2)); });
+  zinhart::multi_core::task_handle<void> e = t.push(0, [](){});
+  ASSERT_EQ(t.pending(), std::uint64_t{5});
+  ASSERT_EQ(t.get(c), "apples");
+  ASSERT_EQ(t.get(a), 'a');
+  ASSERT_EQ(*t.get(d), std::uint32_t{2});
+  ASSERT_EQ(t.get(b), std::uint32_t{1});
+  t.get(e);
+  ASSERT_EQ(t.pending(), std::uint64_t{0});
+  ASSERT_FALSE(t.valid(a));
+  ASSERT_THROW(t.get(a), std::out_of_range);
+
+  // a handle re-typed by hand is caught rather than reinterpreting the result
+  zinhart::multi_core::task_handle<std::uint32_t> f = t.push(0, [](std::uint32_t num){ return num; }, 3);
+  ASSERT_THROW(t.get(zinhart::multi_core::task_handle<std::string>(f)), std::invalid_argument);
+  ASSERT_EQ(t.get(f), std::uint32_t{3});
+}
+
+TEST(task_manager, heterogeneous_results_are_not_copied)
+{
+  zinhart::multi_core::task_manager<zinhart::multi_core::heterogeneous> t;
+  copy_counter::copies = 0;
+  zinhart::multi_core::task_handle<copy_counter> a = t.push(0, [](){ return copy_counter(42); });
+  copy_counter result = t.get(a);
+  ASSERT_EQ(std::uint32_t{42}, result.id);
+  ASSERT_EQ(copy_counter::copies, std::uint32_t{0});
 }
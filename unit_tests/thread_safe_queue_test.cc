@@ -301,3 +301,57 @@ TEST(thread_safe_queue, call_pop_on_available_on_non_empty_queue)
   }
 
 }
+
+// size and empty are lock free so once every writer has joined they should agree with the locked variants
+TEST(thread_safe_queue, call_size_exact_and_empty_exact)
+{
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<std::uint32_t> thread_dist(1, MAX_CPU_THREADS);
+  std::uint32_t n_threads = thread_dist(mt), i;
+  std::vector<std::thread> threads(n_threads); 
+  auto call_push = [](zinhart::multi_core::thread_safe_queue<std::uint32_t>  & init_queue, std::uint32_t item)
+  {
+	init_queue.push(item);
+	ASSERT_EQ(bool{false}, init_queue.empty_exact());
+  };
+  zinhart::multi_core::thread_safe_queue<std::uint32_t> test_queue;
+  ASSERT_EQ(bool{true}, test_queue.empty_exact());
+  ASSERT_EQ(std::uint32_t{0}, test_queue.size_exact());
+  for( i = 0; i < n_threads; ++i)
+	threads[i] = std::thread(call_push, std::ref(test_queue), i + 1 );
+  for(std::thread & t : threads)
+	t.join();
+  ASSERT_EQ(n_threads, test_queue.size_exact());
+  ASSERT_EQ(test_queue.size_exact(), test_queue.size());
+  ASSERT_EQ(test_queue.empty_exact(), test_queue.empty());
+
+  std::uint32_t item;
+  for( i = 0; i < n_threads; ++i)
+	ASSERT_EQ(bool{true}, test_queue.pop(item));
+  ASSERT_EQ(std::uint32_t{0}, test_queue.size_exact());
+  ASSERT_EQ(std::uint32_t{0}, test_queue.size());
+  ASSERT_EQ(bool{true}, test_queue.empty());
+
+  test_queue.push(item);
+  test_queue.clear();
+  ASSERT_EQ(bool{true}, test_queue.empty_exact());
+  ASSERT_EQ(bool{true}, test_queue.empty());
+}
+
+TEST(thread_safe_queue, call_push_n)
+{
+  zinhart::multi_core::thread_safe_queue<std::uint32_t> test_queue;
+  test_queue.push_n(7, 0);
+  ASSERT_EQ(bool{true}, test_queue.empty_exact());
+  test_queue.push_n(7, 5);
+  ASSERT_EQ(std::uint32_t{5}, test_queue.size_exact());
+  ASSERT_EQ(std::uint32_t{5}, test_queue.size());
+  std::uint32_t item;
+  for(std::uint32_t i = 0; i < 5; ++i)
+  {
+	ASSERT_EQ(bool{true}, test_queue.pop(item));
+	ASSERT_EQ(std::uint32_t{7}, item);
+  }
+  ASSERT_EQ(bool{false}, test_queue.pop(item));
+}